@@ -0,0 +1,172 @@
+#pragma once
+
+#if __cplusplus < 202002L
+#error "AsyncQueue.h needs C++20 coroutines; compile with -std=c++20"
+#endif
+
+#include <coroutine> // std::coroutine_handle
+#include <cstddef> // size_t
+#include <memory> // std::addressof
+#include <optional> // std::optional
+#include <utility> // std::move, std::forward
+
+#include "IntrusiveList.h"
+#include "ListHook.h"
+#include "Queue.h"
+
+/*
+    A Queue for coroutines on a single thread. co_await q.pop(executor)
+    completes at once when an element is queued and otherwise
+    suspends the coroutine until one is pushed; there is no need to
+    poll empty() between suspensions.
+
+    A suspended pop waits in an awaiter that lives in the coroutine
+    frame and is linked into the queue's waiter list through its own
+    ListHook, so waiting never allocates. Waiters are served in the
+    order they suspended: push hands its element straight to the
+    longest waiting coroutine and passes its handle to the executor
+    that coroutine named in pop, through executor.schedule(handle).
+    push never resumes a consumer itself, so the consumer runs where
+    its executor runs it, and a consumer that pushes cannot recurse
+    into other consumers. Elements are only stored while nobody waits.
+
+    Destroying a suspended coroutine unlinks its waiter. The queue
+    must outlive every coroutine waiting on it, and must not be
+    shared between threads.
+
+    Example:
+    {
+        AsyncQueue<int> q;
+        Scheduler s; // any type with schedule(std::coroutine_handle<>)
+
+        auto consumer = [&]() -> Task {
+            int value = co_await q.pop(s);
+            std::cout << value << std::endl;
+        };
+
+        consumer();   // suspends in pop
+        q.push(1);    // hands 1 to the consumer and schedules it on s
+        s.run();      // the consumer prints 1
+    }
+*/
+template <typename T, typename Container = List<T>>
+class AsyncQueue {
+    public:
+        using container_type  = Container;
+        using value_type      = typename Container::value_type;
+        using size_type       = typename Container::size_type;
+
+        // Returned by pop(); co_await it for the next element
+        class pop_awaiter {
+            friend AsyncQueue;
+
+            // Hands a handle to the executor passed to pop, whatever its type
+            using schedule_function = void (*)(void*, std::coroutine_handle<>);
+
+            ListHook hook;
+            AsyncQueue* queue;
+            void* executor;
+            schedule_function schedule;
+            std::coroutine_handle<> waiter;
+            std::optional<value_type> value;
+
+            pop_awaiter(AsyncQueue* queue, void* executor, schedule_function schedule) noexcept
+            : queue{queue}, executor{executor}, schedule{schedule} {}
+
+        public:
+            // The waiter list points into the coroutine frame
+            pop_awaiter(const pop_awaiter&) = delete;
+            pop_awaiter& operator=(const pop_awaiter&) = delete;
+
+            ~pop_awaiter() {
+                if(hook.is_linked())
+                {
+                    queue->waiters.erase(*this);
+                }
+            }
+
+            // Earlier waiters have first claim on queued elements
+            bool await_ready() {
+                if(queue->q.empty())
+                {
+                    return false;
+                }
+                value.emplace(std::move(queue->q.front()));
+                queue->q.pop();
+                return true;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept {
+                waiter = handle;
+                queue->waiters.push_back(*this);
+            }
+
+            value_type await_resume() {
+                return std::move(*value);
+            }
+        };
+
+    private:
+        Queue<T, Container> q;
+        IntrusiveList<pop_awaiter, &pop_awaiter::hook> waiters;
+
+    public:
+        AsyncQueue() = default;
+        explicit AsyncQueue(const Container& cont) : q(cont) {}
+        explicit AsyncQueue(Container&& cont) : q(std::move(cont)) {}
+
+        // Waiters hold the queue's address
+        AsyncQueue(const AsyncQueue& other) = delete;
+        AsyncQueue& operator=(const AsyncQueue& other) = delete;
+
+        // A suspended pop is resumed through executor.schedule(handle)
+        template <typename Executor>
+        pop_awaiter pop(Executor& executor) noexcept {
+            return pop_awaiter(this, std::addressof(executor), [](void* target, std::coroutine_handle<> handle) {
+                static_cast<Executor*>(target)->schedule(handle);
+            });
+        }
+
+        void push(const value_type& value) { emplace(value); }
+        void push(value_type&& value) { emplace(std::move(value)); }
+
+        // Hands the new element to the longest waiting coroutine and schedules
+        // it on its executor, or queues the element if no coroutine is waiting
+        template <typename... Args>
+        void emplace(Args&&... args) {
+            if(waiters.empty())
+            {
+                q.emplace(std::forward<Args>(args)...);
+                return;
+            }
+
+            pop_awaiter& next = waiters.front();
+            next.value.emplace(std::forward<Args>(args)...);
+            try {
+                next.schedule(next.executor, next.waiter);
+            }
+            catch(...) {
+                // The executor refused it: the coroutine keeps waiting
+                next.value.reset();
+                throw;
+            }
+            waiters.pop_front();
+        }
+
+        // Take an element without suspending. Returns false if none is queued
+        bool try_pop(value_type& value) {
+            if(q.empty())
+            {
+                return false;
+            }
+            value = std::move(q.front());
+            q.pop();
+            return true;
+        }
+
+        bool empty() const { return q.empty(); }
+        size_type size() const { return q.size(); }
+
+        // Number of coroutines suspended in pop
+        size_type waiting() const { return waiters.size(); }
+};
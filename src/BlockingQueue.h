@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono> // std::chrono::duration
+#include <condition_variable> // std::condition_variable
+#include <cstddef> // size_t
+#include <mutex> // std::mutex, std::unique_lock
+#include <utility> // std::move, std::forward
+
+#include "Queue.h"
+
+/*
+    A Queue guarded by a mutex, with a condition variable so that
+    consumers sleep until an element arrives instead of spinning on
+    empty(). pop_batch drains up to max elements per lock acquisition,
+    which amortises the lock and the wake-up over the whole batch.
+
+    close() ends the queue: pushes are refused from then on, and
+    consumers drain what is left before their pops start failing.
+
+    Example:
+    {
+        BlockingQueue<int> q;
+
+        std::thread consumer([&] {
+            int value;
+            while(q.pop_wait(value))
+                std::cout << value << std::endl;
+        });
+
+        q.push(1);
+        q.close();
+        consumer.join(); // prints 1
+    }
+*/
+template <typename T, typename Container = List<T>>
+class BlockingQueue {
+    public:
+        using container_type  = Container;
+        using value_type      = typename Container::value_type;
+        using size_type       = typename Container::size_type;
+
+    private:
+        Queue<T, Container> q;
+        mutable std::mutex lock;
+        std::condition_variable ready;
+        size_type waiting = 0;
+        bool closed = false;
+
+        // Wake a consumer only if one is asleep. Called with the lock held
+        void notify_one() {
+            if(waiting > 0)
+            {
+                ready.notify_one();
+            }
+        }
+
+        // Sleep until an element arrives, the queue closes or the deadline
+        // passes. Returns whether an element is available
+        template <typename Clock, typename Duration>
+        bool wait_until(std::unique_lock<std::mutex>& held, const std::chrono::time_point<Clock, Duration>& deadline) {
+            waiting++;
+            bool available = ready.wait_until(held, deadline, [this] { return !q.empty() || closed; });
+            waiting--;
+            return available && !q.empty();
+        }
+
+        value_type take() {
+            value_type value = std::move(q.front());
+            q.pop();
+            return value;
+        }
+
+    public:
+        BlockingQueue() = default;
+        explicit BlockingQueue(const Container& cont) : q(cont) {}
+        explicit BlockingQueue(Container&& cont) : q(std::move(cont)) {}
+
+        // Threads share the queue by address
+        BlockingQueue(const BlockingQueue& other) = delete;
+        BlockingQueue& operator=(const BlockingQueue& other) = delete;
+
+        // Each returns false, dropping the element, once the queue is closed
+        bool push(const value_type& value) { return emplace(value); }
+        bool push(value_type&& value) { return emplace(std::move(value)); }
+        template <typename... Args>
+        bool emplace(Args&&... args) {
+            std::lock_guard<std::mutex> held(lock);
+            if(closed)
+            {
+                return false;
+            }
+            q.emplace(std::forward<Args>(args)...);
+            notify_one();
+            return true;
+        }
+
+        // Block until an element can be moved into value. Returns false
+        // once the queue is closed and empty
+        bool pop_wait(value_type& value) {
+            std::unique_lock<std::mutex> held(lock);
+            waiting++;
+            ready.wait(held, [this] { return !q.empty() || closed; });
+            waiting--;
+
+            if(q.empty())
+            {
+                return false;
+            }
+            value = take();
+            return true;
+        }
+
+        // As pop_wait, but gives up after timeout
+        template <typename Rep, typename Period>
+        bool try_pop_for(value_type& value, const std::chrono::duration<Rep, Period>& timeout) {
+            std::unique_lock<std::mutex> held(lock);
+            if(!wait_until(held, std::chrono::steady_clock::now() + timeout))
+            {
+                return false;
+            }
+            value = take();
+            return true;
+        }
+
+        // Wait up to timeout for an element, then move up to max elements
+        // to out under a single lock acquisition. Returns the number moved
+        template <typename OutputIt, typename Rep, typename Period>
+        size_type pop_batch(OutputIt out, size_type max, const std::chrono::duration<Rep, Period>& timeout) {
+            std::unique_lock<std::mutex> held(lock);
+            if(max == 0 || !wait_until(held, std::chrono::steady_clock::now() + timeout))
+            {
+                return 0;
+            }
+
+            size_type count = 0;
+            for(; count < max && !q.empty(); count++, ++out)
+            {
+                *out = take();
+            }
+            return count;
+        }
+
+        // Refuse further pushes and wake every waiting consumer
+        void close() {
+            std::lock_guard<std::mutex> held(lock);
+            closed = true;
+            ready.notify_all();
+        }
+
+        bool is_closed() const {
+            std::lock_guard<std::mutex> held(lock);
+            return closed;
+        }
+
+        bool empty() const {
+            std::lock_guard<std::mutex> held(lock);
+            return q.empty();
+        }
+
+        size_type size() const {
+            std::lock_guard<std::mutex> held(lock);
+            return q.size();
+        }
+};
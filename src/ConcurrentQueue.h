@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic> // std::atomic
+#include <cstddef> // size_t
+#include <new> // placement new, std::launder
+#include <utility> // std::move, std::forward
+
+#include "HazardPointer.h" // HazardDomain
+
+/*
+    An unbounded multi-producer/multi-consumer FIFO queue after
+    Michael and Scott. Producers append by swinging the tail node's
+    next link with a CAS; consumers advance the head past a dummy
+    node. Neither side ever takes a lock, so a stalled thread cannot
+    block the others.
+
+    Unlinked nodes are reclaimed through hazard pointers, so a node
+    is never freed while another thread may still be reading it.
+
+    Elements are handed out by try_pop, which moves the value into
+    its argument; T's move assignment should not throw.
+
+    Example:
+    {
+        ConcurrentQueue<int> q;
+
+        std::thread producer([&] { q.push(1); });
+        producer.join();
+
+        int value;
+        if(q.try_pop(value))
+            std::cout << value << std::endl; // 1
+    }
+*/
+template <class T>
+class ConcurrentQueue {
+    private:
+    struct Node {
+        std::atomic<Node*> next;
+        // Live only while the node is behind the head dummy
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        Node() : next{nullptr} {}
+
+        T* data() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+
+        // Retired nodes are dummies, so only the node itself is freed
+        static void reclaim(void* node) {
+            delete static_cast<Node*>(node);
+        }
+    };
+
+    // Head and tail sit on separate cache lines so producers and
+    // consumers do not invalidate each other
+    alignas(64) std::atomic<Node*> _head;
+    alignas(64) std::atomic<Node*> _tail;
+
+    // Append a node whose value has already been constructed
+    void link_node(Node* node) noexcept {
+        HazardDomain::Record& record = HazardDomain::local();
+
+        while(true)
+        {
+            Node* tail = record.protect(0, _tail);
+            Node* next = tail->next.load();
+
+            if(next == nullptr)
+            {
+                if(tail->next.compare_exchange_weak(next, node))
+                {
+                    // Failure means another thread already advanced the tail
+                    _tail.compare_exchange_strong(tail, node);
+                    break;
+                }
+            }
+            else
+            {
+                // The tail is lagging; help it along before retrying
+                _tail.compare_exchange_strong(tail, next);
+            }
+        }
+
+        record.clear(0);
+    }
+
+public:
+    using value_type = T;
+    using size_type  = size_t;
+
+    ConcurrentQueue() : _head{nullptr}, _tail{nullptr} {
+        Node* dummy = new Node();
+        _head.store(dummy);
+        _tail.store(dummy);
+    }
+
+    // The queue is shared by address between threads
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    // Must not race with any other operation
+    ~ConcurrentQueue() {
+        Node* node = _head.load();
+        Node* next = node->next.load();
+        delete node;
+
+        while(next != nullptr)
+        {
+            node = next;
+            next = node->next.load();
+            node->data()->~T();
+            delete node;
+        }
+    }
+
+    void push( const T& value ) {
+        emplace(value);
+    }
+    void push( T&& value ) {
+        emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    void emplace( Args&&... args ) {
+        Node* node = new Node();
+        try
+        {
+            ::new(static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            delete node;
+            throw;
+        }
+        link_node(node);
+    }
+
+    // Move the oldest element into value. Returns false if the queue was empty
+    bool try_pop( T& value ) {
+        HazardDomain::Record& record = HazardDomain::local();
+
+        while(true)
+        {
+            Node* head = record.protect(0, _head);
+            Node* tail = _tail.load();
+            Node* next = record.protect(1, head->next);
+
+            // next is only safe to use if head was still current after it was published
+            if(head != _head.load())
+            {
+                continue;
+            }
+
+            if(next == nullptr)
+            {
+                record.clear(0);
+                record.clear(1);
+                return false;
+            }
+
+            if(head == tail)
+            {
+                // The tail is lagging behind a pushed node
+                _tail.compare_exchange_strong(tail, next);
+                continue;
+            }
+
+            if(_head.compare_exchange_strong(head, next))
+            {
+                // next is the new dummy; its value now belongs to this thread
+                T* data = next->data();
+                value = std::move(*data);
+                data->~T();
+
+                record.clear(0);
+                record.clear(1);
+                record.retire(head, &Node::reclaim);
+                return true;
+            }
+        }
+    }
+
+    // A snapshot which may be stale by the time it is returned
+    bool empty() const noexcept {
+        HazardDomain::Record& record = HazardDomain::local();
+
+        Node* head = record.protect(0, _head);
+        bool result = head->next.load() == nullptr;
+        record.clear(0);
+        return result;
+    }
+};
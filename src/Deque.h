@@ -0,0 +1,618 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <memory> // std::allocator, std::allocator_traits
+#include <type_traits> // std::enable_if, std::is_const
+#include <utility> // std::move, std::forward, std::swap
+
+#include "IteratorComparisons.h" // const/non-const iterator comparisons
+
+// Default number of elements per block: a power of two near 512 bytes of payload
+template <class T>
+constexpr size_t deque_block_capacity() {
+    size_t capacity = 16;
+    while(capacity * 2 * sizeof(T) <= 512)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/*
+    A double-ended queue over fixed-size blocks of N elements, found
+    through a map of block pointers. Pushing at either end fills the
+    end block before a new one is needed, and popping never moves the
+    remaining elements, so references stay valid until their element
+    is removed.
+
+    Blocks emptied by pop_front or pop_back are kept as spares (up to
+    spare_blocks of them) and handed out again before the allocator is
+    asked for more, so a FIFO that holds a steady number of elements
+    cycles through the same few blocks without allocating. Call
+    shrink_to_fit to give the spares back.
+
+    Deque provides the interface Queue uses and can replace its
+    default container:
+
+    Example:
+    {
+        Queue<int, Deque<int>> q;
+
+        for(int value = 0; value < 1000; value++)
+        {
+            q.push(value);
+            q.pop(); // after the first block, no further allocations
+        }
+    }
+*/
+template <class T, size_t N = deque_block_capacity<T>(), class Allocator = std::allocator<T>>
+class Deque {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Deque blocks must hold a power of two elements");
+
+    private:
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+        using list_type         = Deque;
+    private:
+        template <typename, typename>
+        friend class basic_iterator;
+        friend Deque;
+
+        // A position counted from the front, so blocks may come and go at
+        // the other end without invalidating it
+        Deque* deque;
+        size_t index;
+
+        basic_iterator(const Deque* deque, size_t index) noexcept
+        : deque{const_cast<Deque*>(deque)}, index{index} {}
+
+    public:
+        basic_iterator() : deque{nullptr}, index{0} {}
+        basic_iterator(const basic_iterator&) = default;
+        basic_iterator(basic_iterator&&) = default;
+        ~basic_iterator() = default;
+        basic_iterator& operator=(const basic_iterator&) = default;
+        basic_iterator& operator=(basic_iterator&&) = default;
+
+        reference operator*() const {
+            return *deque->slot(index);
+        }
+        pointer operator->() const {
+            return deque->slot(index);
+        }
+        reference operator[](difference_type offset) const {
+            return *deque->slot(index + offset);
+        }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            index++;
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            index--;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        basic_iterator& operator+=(difference_type offset) {
+            index += offset;
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type offset) {
+            index -= offset;
+            return *this;
+        }
+        basic_iterator operator+(difference_type offset) const {
+            return basic_iterator(deque, index + offset);
+        }
+        friend basic_iterator operator+(difference_type offset, const basic_iterator& it) {
+            return it + offset;
+        }
+        basic_iterator operator-(difference_type offset) const {
+            return basic_iterator(deque, index - offset);
+        }
+        difference_type operator-(const basic_iterator& other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        // Non-const iterators convert to const_iterator
+        template <typename P = pointer_type,
+                  typename = typename std::enable_if<!std::is_const<typename std::remove_pointer<P>::type>::value>::type>
+        operator basic_iterator<const T*, const T&>() const noexcept {
+            return basic_iterator<const T*, const T&>(deque, index);
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept {
+            return this->deque == other.deque && this->index == other.index;
+        }
+        bool operator!=(const basic_iterator& other) const noexcept {
+            return !(*this == other);
+        }
+        bool operator<(const basic_iterator& other) const noexcept {
+            return this->index < other.index;
+        }
+        bool operator>(const basic_iterator& other) const noexcept {
+            return other < *this;
+        }
+        bool operator<=(const basic_iterator& other) const noexcept {
+            return !(other < *this);
+        }
+        bool operator>=(const basic_iterator& other) const noexcept {
+            return !(*this < other);
+        }
+    };
+
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+    static constexpr size_type block_capacity = N;
+    static constexpr size_type spare_blocks = 2;
+
+private:
+    using alloc_traits     = std::allocator_traits<Allocator>;
+    using map_allocator    = typename alloc_traits::template rebind_alloc<T*>;
+    using map_traits       = std::allocator_traits<map_allocator>;
+
+    // Live blocks are _map[_map_begin, _map_end). The front element sits
+    // at slot _start of the first block
+    T** _map;
+    size_type _map_capacity;
+    size_type _map_begin;
+    size_type _map_end;
+    size_type _start;
+    size_type _size;
+
+    // Emptied blocks waiting to be reused
+    T* _spare[spare_blocks];
+    size_type _spare_count;
+
+    Allocator _alloc;
+
+    T* slot(size_type index) const noexcept {
+        size_type offset = _start + index;
+        return _map[_map_begin + offset / N] + offset % N;
+    }
+
+    T* take_block() {
+        if(_spare_count > 0)
+        {
+            return _spare[--_spare_count];
+        }
+        return alloc_traits::allocate(_alloc, N);
+    }
+
+    void give_block(T* block) noexcept {
+        if(_spare_count < spare_blocks)
+        {
+            _spare[_spare_count++] = block;
+        }
+        else
+        {
+            alloc_traits::deallocate(_alloc, block, N);
+        }
+    }
+
+    void release_spares() noexcept {
+        while(_spare_count > 0)
+        {
+            alloc_traits::deallocate(_alloc, _spare[--_spare_count], N);
+        }
+    }
+
+    // Make room in the map for one more block at the front or the back.
+    // Recentres the live blocks if the map is mostly free, else doubles it
+    void reserve_map_slot(bool at_front) {
+        if(at_front ? _map_begin > 0 : _map_end < _map_capacity)
+        {
+            return;
+        }
+
+        size_type live = _map_end - _map_begin;
+        size_type capacity = _map_capacity;
+        if(capacity < 2 * (live + 1))
+        {
+            capacity = capacity == 0 ? 8 : capacity * 2;
+        }
+        size_type begin = (capacity - live) / 2 + (at_front ? 1 : 0);
+        if(begin + live > capacity)
+        {
+            begin = capacity - live;
+        }
+
+        if(capacity == _map_capacity)
+        {
+            // Shifting within the same map; copy in the safe direction
+            if(begin < _map_begin)
+            {
+                for(size_type index = 0; index < live; index++)
+                {
+                    _map[begin + index] = _map[_map_begin + index];
+                }
+            }
+            else
+            {
+                for(size_type index = live; index > 0; index--)
+                {
+                    _map[begin + index - 1] = _map[_map_begin + index - 1];
+                }
+            }
+        }
+        else
+        {
+            map_allocator map_alloc(_alloc);
+            T** map = map_traits::allocate(map_alloc, capacity);
+            for(size_type index = 0; index < live; index++)
+            {
+                map[begin + index] = _map[_map_begin + index];
+            }
+            if(_map != nullptr)
+            {
+                map_traits::deallocate(map_alloc, _map, _map_capacity);
+            }
+            _map = map;
+            _map_capacity = capacity;
+        }
+
+        _map_begin = begin;
+        _map_end = begin + live;
+    }
+
+    void release_map() noexcept {
+        if(_map != nullptr)
+        {
+            map_allocator map_alloc(_alloc);
+            map_traits::deallocate(map_alloc, _map, _map_capacity);
+        }
+        _map = nullptr;
+        _map_capacity = _map_begin = _map_end = 0;
+    }
+
+    // Free every block and the map. Elements must already be destroyed
+    void release_storage() noexcept {
+        for(size_type index = _map_begin; index < _map_end; index++)
+        {
+            alloc_traits::deallocate(_alloc, _map[index], N);
+        }
+        release_spares();
+        release_map();
+        _start = 0;
+    }
+
+    // Take ownership of other's blocks. Both deques must share an allocator
+    void steal_storage(Deque& other) noexcept {
+        _map = other._map;
+        _map_capacity = other._map_capacity;
+        _map_begin = other._map_begin;
+        _map_end = other._map_end;
+        _start = other._start;
+        _size = other._size;
+        _spare_count = other._spare_count;
+        for(size_type index = 0; index < _spare_count; index++)
+        {
+            _spare[index] = other._spare[index];
+        }
+
+        other._map = nullptr;
+        other._map_capacity = other._map_begin = other._map_end = 0;
+        other._start = other._size = other._spare_count = 0;
+    }
+
+public:
+    Deque(): Deque(Allocator()) {}
+    explicit Deque( const Allocator& alloc )
+    : _map(nullptr), _map_capacity(0), _map_begin(0), _map_end(0), _start(0), _size(0),
+      _spare_count(0), _alloc(alloc) {}
+    Deque( size_type count, const T& value, const Allocator& alloc = Allocator() ): Deque(alloc) {
+        for(size_type num = 0; num < count; num++)
+        {
+            push_back(value);
+        }
+    }
+    explicit Deque( size_type count, const Allocator& alloc = Allocator() ): Deque(alloc) {
+        for(size_type num = 0; num < count; num++)
+        {
+            emplace_back();
+        }
+    }
+    Deque( const Deque& other ): Deque(alloc_traits::select_on_container_copy_construction(other._alloc)) {
+        for(const_iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+        {
+            push_back(*currentSpot);
+        }
+    }
+    Deque( Deque&& other ): Deque(std::move(other._alloc)) {
+        steal_storage(other);
+    }
+    ~Deque() {
+        clear();
+        release_storage();
+    }
+    Deque& operator=( const Deque& other ) {
+        if(this != &other)
+        {
+            clear();
+            if(alloc_traits::propagate_on_container_copy_assignment::value && _alloc != other._alloc)
+            {
+                release_storage();
+                _alloc = other._alloc;
+            }
+
+            for(const_iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+            {
+                push_back(*currentSpot);
+            }
+        }
+        return *this;
+    }
+    Deque& operator=( Deque&& other ) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if(this != &other)
+        {
+            clear();
+            if(alloc_traits::propagate_on_container_move_assignment::value || _alloc == other._alloc)
+            {
+                release_storage();
+                if(alloc_traits::propagate_on_container_move_assignment::value)
+                {
+                    _alloc = std::move(other._alloc);
+                }
+                steal_storage(other);
+            }
+            else
+            {
+                for(iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+                {
+                    push_back(std::move(*currentSpot));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return _alloc;
+    }
+
+    reference front() {
+        return *slot(0);
+    }
+    const_reference front() const {
+        return *slot(0);
+    }
+
+    reference back() {
+        return *slot(_size - 1);
+    }
+    const_reference back() const {
+        return *slot(_size - 1);
+    }
+
+    reference operator[]( size_type index ) {
+        return *slot(index);
+    }
+    const_reference operator[]( size_type index ) const {
+        return *slot(index);
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, _size);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, _size);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(this, _size);
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    // Blocks held for reuse, not counting those holding elements
+    size_type spare_count() const noexcept {
+        return _spare_count;
+    }
+
+    // Destroy every element. Emptied blocks become spares as usual
+    void clear() noexcept {
+        while(_size > 0)
+        {
+            pop_back();
+        }
+    }
+
+    // Give spare blocks back to the allocator
+    void shrink_to_fit() noexcept {
+        release_spares();
+        if(_map_begin == _map_end)
+        {
+            release_map();
+            _start = 0;
+        }
+    }
+
+    void push_back( const T& value ) {
+        emplace_back(value);
+    }
+    void push_back( T&& value ) {
+        emplace_back(std::move(value));
+    }
+    template <typename... Args>
+    reference emplace_back( Args&&... args ) {
+        size_type offset = _start + _size;
+        if(_map_begin + offset / N == _map_end)
+        {
+            reserve_map_slot(false);
+            _map[_map_end] = take_block();
+            _map_end++;
+        }
+
+        T* target = _map[_map_begin + offset / N] + offset % N;
+        try
+        {
+            alloc_traits::construct(_alloc, target, std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            if(offset % N == 0)
+            {
+                give_block(_map[--_map_end]);
+            }
+            throw;
+        }
+        _size++;
+        return *target;
+    }
+
+    void pop_back() {
+        alloc_traits::destroy(_alloc, slot(_size - 1));
+        _size--;
+
+        // Hand back the last block once it holds nothing
+        size_type offset = _start + _size;
+        if(_size == 0 || (offset % N == 0 && _map_begin + offset / N < _map_end))
+        {
+            give_block(_map[--_map_end]);
+            if(_map_begin == _map_end)
+            {
+                _start = 0;
+            }
+        }
+    }
+
+    void push_front( const T& value ) {
+        emplace_front(value);
+    }
+    void push_front( T&& value ) {
+        emplace_front(std::move(value));
+    }
+    template <typename... Args>
+    reference emplace_front( Args&&... args ) {
+        bool new_block = _start == 0;
+        if(new_block)
+        {
+            reserve_map_slot(true);
+            _map[_map_begin - 1] = take_block();
+            _map_begin--;
+            _start = N;
+        }
+
+        T* target = _map[_map_begin] + (_start - 1);
+        try
+        {
+            alloc_traits::construct(_alloc, target, std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            if(new_block)
+            {
+                give_block(_map[_map_begin++]);
+                _start = 0;
+            }
+            throw;
+        }
+        _start--;
+        _size++;
+        return *target;
+    }
+
+    void pop_front() {
+        alloc_traits::destroy(_alloc, slot(0));
+        _start++;
+        _size--;
+
+        // Hand back the first block once it holds nothing
+        if(_start == N || _size == 0)
+        {
+            give_block(_map[_map_begin++]);
+            _start = 0;
+        }
+    }
+
+    // Batched push_back and pop_front, for Queue's push_range and pop_n
+    template <typename InputIt>
+    void append_range( InputIt first, InputIt last ) {
+        for(; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+    template <typename OutputIt>
+    size_type pop_front_n( OutputIt out, size_type count ) {
+        size_type popped = 0;
+        for(; popped < count && _size > 0; popped++, ++out)
+        {
+            *out = std::move(front());
+            pop_front();
+        }
+        return popped;
+    }
+
+    // Exchange contents in O(1). Allocators are swapped only if they propagate
+    void swap( Deque& other ) noexcept {
+        if(this == &other)
+        {
+            return;
+        }
+
+        if(alloc_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        Deque temp(_alloc);
+        temp.steal_storage(*this);
+        steal_storage(other);
+        other.steal_storage(temp);
+    }
+};
+
+template <class T, size_t N, class Allocator>
+void swap(Deque<T, N, Allocator>& lhs, Deque<T, N, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <atomic> // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstddef> // size_t
+#include <functional> // std::function
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex, std::unique_lock, std::lock_guard
+#include <thread> // std::thread, std::this_thread::yield
+#include <utility> // std::forward
+#include <vector> // std::vector
+
+#include "Deque.h"
+#include "Queue.h"
+#include "WorkStealingDeque.h"
+
+/*
+    A fixed pool of worker threads that share work by stealing. Each
+    worker owns a WorkStealingDeque: tasks submitted from inside a
+    task go onto the submitting worker's deque and are popped newest
+    first, which keeps a fork-join computation depth first and cache
+    warm. Idle workers steal the oldest task from a random victim,
+    which hands them the largest remaining subproblem.
+
+    Tasks submitted from outside the pool go to a shared injection
+    queue that workers check when their own deque is empty. Workers
+    with nothing to do sleep until a task is submitted.
+
+    wait_idle blocks until every submitted task, including the ones
+    those tasks submitted, has finished. It must not be called from a
+    task. An exception escaping a task terminates the program, as it
+    would from a std::thread.
+
+    Example:
+    {
+        Executor pool(4);
+        std::atomic<int> sum { 0 };
+
+        for(int value = 1; value <= 10; value++)
+            pool.submit([&, value] { sum += value; });
+
+        pool.wait_idle();
+        std::cout << sum << std::endl; // 55
+    }
+*/
+class Executor {
+    public:
+    using task_type = std::function<void()>;
+    using size_type = size_t;
+
+    private:
+    struct Worker {
+        Executor* owner;
+        WorkStealingDeque<task_type*> tasks;
+        std::thread thread;
+        size_type victim_seed;
+
+        Worker(Executor* owner, size_type seed) : owner{owner}, victim_seed{seed} {}
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // Tasks submitted from outside the pool
+    Queue<task_type*, Deque<task_type*>> _injected;
+    std::atomic<size_type> _injected_count;
+
+    // Tasks waiting in any queue, and tasks not yet finished
+    std::atomic<size_type> _queued;
+    std::atomic<size_type> _pending;
+
+    // Guards _injected, sleeping and stopping
+    std::mutex _lock;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    std::atomic<size_type> _sleeping;
+    bool _stopping;
+
+    // The worker running on this thread, if it belongs to any executor
+    static Worker*& current_worker() noexcept {
+        static thread_local Worker* worker = nullptr;
+        return worker;
+    }
+
+    // Counts the task as queued and pending before any worker can see it
+    void enqueue(task_type* task) {
+        _pending++;
+        _queued++;
+
+        Worker* worker = current_worker();
+        try
+        {
+            if(worker != nullptr && worker->owner == this)
+            {
+                worker->tasks.push(task);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> held(_lock);
+                _injected.push(task);
+                _injected_count++;
+            }
+        }
+        catch(...)
+        {
+            _queued--;
+            _pending--;
+            throw;
+        }
+
+        // A sleeper either sees the task in _queued or is counted here
+        if(_sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> held(_lock);
+            _wake.notify_one();
+        }
+    }
+
+    task_type* take_injected() {
+        if(_injected_count.load() == 0)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> held(_lock);
+        if(_injected.empty())
+        {
+            return nullptr;
+        }
+        task_type* task = _injected.front();
+        _injected.pop();
+        _injected_count--;
+        return task;
+    }
+
+    // Own deque first, then the injection queue, then the other workers
+    task_type* find_task(Worker& self) {
+        task_type* task = nullptr;
+        if(self.tasks.pop(task))
+        {
+            return task;
+        }
+
+        task = take_injected();
+        if(task != nullptr)
+        {
+            return task;
+        }
+
+        // xorshift picks where the round of victims starts
+        self.victim_seed ^= self.victim_seed << 13;
+        self.victim_seed ^= self.victim_seed >> 7;
+        self.victim_seed ^= self.victim_seed << 17;
+
+        size_type count = _workers.size();
+        size_type start = self.victim_seed % count;
+        for(size_type offset = 0; offset < count; offset++)
+        {
+            Worker& victim = *_workers[(start + offset) % count];
+            if(&victim != &self && victim.tasks.steal(task))
+            {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void execute(task_type* task) noexcept {
+        _queued--;
+        (*task)();
+        delete task;
+
+        if(--_pending == 0)
+        {
+            std::lock_guard<std::mutex> held(_lock);
+            _idle.notify_all();
+        }
+    }
+
+    void run(Worker& self) {
+        current_worker() = &self;
+        while(true)
+        {
+            task_type* task = find_task(self);
+            if(task != nullptr)
+            {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> held(_lock);
+            if(_queued.load() > 0)
+            {
+                // Some task is in flight between queues; look again
+                held.unlock();
+                std::this_thread::yield();
+                continue;
+            }
+            if(_stopping)
+            {
+                break;
+            }
+
+            _sleeping++;
+            _wake.wait(held, [this] { return _queued.load() > 0 || _stopping; });
+            _sleeping--;
+        }
+        current_worker() = nullptr;
+    }
+
+public:
+    explicit Executor( size_type threads = std::thread::hardware_concurrency() )
+    : _injected_count{0}, _queued{0}, _pending{0}, _sleeping{0}, _stopping{false} {
+        if(threads == 0)
+        {
+            threads = 1;
+        }
+
+        for(size_type index = 0; index < threads; index++)
+        {
+            _workers.emplace_back(new Worker(this, 0x9E3779B97F4A7C15ULL * (index + 1)));
+        }
+        try
+        {
+            for(std::unique_ptr<Worker>& worker : _workers)
+            {
+                Worker* self = worker.get();
+                worker->thread = std::thread([this, self] { run(*self); });
+            }
+        }
+        catch(...)
+        {
+            // Stop the workers already running before giving up
+            {
+                std::lock_guard<std::mutex> held(_lock);
+                _stopping = true;
+            }
+            _wake.notify_all();
+
+            for(std::unique_ptr<Worker>& worker : _workers)
+            {
+                if(worker->thread.joinable())
+                {
+                    worker->thread.join();
+                }
+            }
+            throw;
+        }
+    }
+
+    // Threads share the executor by address
+    Executor( const Executor& other ) = delete;
+    Executor& operator=( const Executor& other ) = delete;
+
+    // Runs every submitted task to completion before joining the workers
+    ~Executor() {
+        wait_idle();
+        {
+            std::lock_guard<std::mutex> held(_lock);
+            _stopping = true;
+        }
+        _wake.notify_all();
+
+        for(std::unique_ptr<Worker>& worker : _workers)
+        {
+            worker->thread.join();
+        }
+    }
+
+    size_type size() const noexcept {
+        return _workers.size();
+    }
+
+    template <typename Fn>
+    void submit( Fn&& fn ) {
+        task_type* task = new task_type(std::forward<Fn>(fn));
+        try
+        {
+            enqueue(task);
+        }
+        catch(...)
+        {
+            delete task;
+            throw;
+        }
+    }
+
+    // Block until no submitted task is queued or running
+    void wait_idle() {
+        std::unique_lock<std::mutex> held(_lock);
+        _idle.wait(held, [this] { return _pending.load() == 0; });
+    }
+};
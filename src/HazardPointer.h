@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic> // std::atomic
+#include <cstddef> // size_t
+#include <thread> // std::this_thread::yield
+#include <vector> // std::vector
+
+/*
+    Safe memory reclamation for lock-free containers using hazard
+    pointers. Before dereferencing a shared node a thread publishes
+    its address in one of its hazard slots; a node that has been
+    unlinked is retired rather than deleted, and is only reclaimed
+    once no published hazard refers to it.
+
+    Every thread owns one record, acquired on first use and handed
+    back to the domain when the thread exits. Records are never
+    freed while the domain lives, so scanning them needs no locks.
+
+    Example:
+    {
+        HazardDomain::Record& record = HazardDomain::local();
+
+        Node* node = record.protect(0, shared_head);
+        // ... node cannot be reclaimed here ...
+        record.clear(0);
+
+        record.retire(node, [](void* ptr) { delete static_cast<Node*>(ptr); });
+    }
+*/
+class HazardDomain {
+    public:
+    static constexpr size_t slots_per_thread = 2;
+
+    class Record {
+        friend HazardDomain;
+
+        struct Retired {
+            void* ptr;
+            void (*reclaim)(void*);
+        };
+
+        std::atomic<const void*> hazards[slots_per_thread];
+        std::atomic<bool> active;
+        Record* next;
+        HazardDomain* domain;
+        // Only touched by the owning thread
+        std::vector<Retired> retired;
+
+        // Room for a full batch up front, so retiring does not allocate
+        explicit Record(HazardDomain* domain) : hazards{}, active{true}, next{nullptr}, domain{domain} {
+            retired.reserve(domain->scan_threshold());
+        }
+
+        public:
+        // Publish the current value of source in slot and return it once
+        // the publication is known to have happened before any reclamation
+        template <typename T>
+        T* protect(size_t slot, const std::atomic<T*>& source) noexcept {
+            T* ptr = source.load();
+            while(true)
+            {
+                hazards[slot].store(ptr);
+                T* current = source.load();
+                if(current == ptr)
+                {
+                    return ptr;
+                }
+                ptr = current;
+            }
+        }
+
+        void clear(size_t slot) noexcept {
+            hazards[slot].store(nullptr, std::memory_order_release);
+        }
+
+        // Hand over an unlinked pointer, reclaiming it once it is unprotected
+        void retire(void* ptr, void (*reclaim)(void*)) noexcept {
+            if(retired.size() == retired.capacity())
+            {
+                domain->make_room(*this);
+            }
+            retired.push_back(Retired{ptr, reclaim});
+            if(retired.size() >= domain->scan_threshold())
+            {
+                domain->scan(*this);
+            }
+        }
+    };
+
+    HazardDomain() : _records{nullptr}, _record_count{0} {}
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+
+    // Called once every thread has stopped using the domain
+    ~HazardDomain() {
+        Record* record = _records.load();
+        while(record != nullptr)
+        {
+            for(Record::Retired& node : record->retired)
+            {
+                node.reclaim(node.ptr);
+            }
+            Record* next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    // The domain shared by every lock-free container
+    static HazardDomain& global() {
+        static HazardDomain domain;
+        return domain;
+    }
+
+    // The calling thread's record in the global domain
+    static Record& local() {
+        thread_local Owner owner(global());
+        return *owner.record;
+    }
+
+    private:
+    // Releases a thread's record when the thread exits
+    struct Owner {
+        HazardDomain& domain;
+        Record* record;
+
+        explicit Owner(HazardDomain& domain) : domain{domain}, record{domain.acquire()} {}
+        ~Owner() {
+            domain.release(*record);
+        }
+    };
+
+    std::atomic<Record*> _records;
+    std::atomic<size_t> _record_count;
+
+    // Reuse an inactive record or publish a new one
+    Record* acquire() {
+        for(Record* record = _records.load(); record != nullptr; record = record->next)
+        {
+            bool expected = false;
+            if(!record->active.load() && record->active.compare_exchange_strong(expected, true))
+            {
+                return record;
+            }
+        }
+
+        Record* record = new Record(this);
+        Record* head = _records.load();
+        do
+        {
+            record->next = head;
+        } while(!_records.compare_exchange_weak(head, record));
+        _record_count++;
+        return record;
+    }
+
+    // Retired pointers stay with the record for its next owner
+    void release(Record& record) noexcept {
+        for(size_t slot = 0; slot < slots_per_thread; slot++)
+        {
+            record.clear(slot);
+        }
+        scan(record);
+        record.active.store(false);
+    }
+
+    // Scanning is amortised over a number of retirements proportional
+    // to the number of hazards that could block them
+    size_t scan_threshold() const noexcept {
+        return 2 * slots_per_thread * _record_count.load(std::memory_order_relaxed) + 16;
+    }
+
+    // The threshold grows as threads join, so a record's batch can
+    // outgrow the room it reserved. If growing fails, reclaim instead,
+    // waiting out the hazards if every retired pointer is protected
+    void make_room(Record& record) noexcept {
+        try
+        {
+            record.retired.reserve(scan_threshold());
+            return;
+        }
+        catch(...)
+        {
+        }
+
+        scan(record);
+        while(record.retired.size() == record.retired.capacity())
+        {
+            std::this_thread::yield();
+            scan(record);
+        }
+    }
+
+    bool is_protected(const void* ptr) const noexcept {
+        for(Record* other = _records.load(); other != nullptr; other = other->next)
+        {
+            for(size_t slot = 0; slot < slots_per_thread; slot++)
+            {
+                if(other->hazards[slot].load() == ptr)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Reclaim every pointer retired by record that no thread protects.
+    // Hazards are read in place rather than copied out, so this never allocates
+    void scan(Record& record) noexcept {
+        size_t kept = 0;
+        for(size_t index = 0; index < record.retired.size(); index++)
+        {
+            Record::Retired node = record.retired[index];
+
+            if(is_protected(node.ptr))
+            {
+                record.retired[kept++] = node;
+            }
+            else
+            {
+                node.reclaim(node.ptr);
+            }
+        }
+        record.retired.resize(kept);
+    }
+};
@@ -0,0 +1,559 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstdint> // std::uint32_t
+#include <initializer_list> // std::initializer_list
+#include <iterator> // std::bidirectional_iterator_tag
+#include <memory> // std::allocator, std::allocator_traits
+#include <new> // placement new, std::launder
+#include <stdexcept> // std::length_error
+#include <type_traits> // std::is_same, std::enable_if
+#include <utility> // std::move, std::forward, std::swap, std::move_if_noexcept
+
+#include "IteratorComparisons.h" // const/non-const iterator comparisons
+
+/*
+    A doubly linked list whose nodes live in one contiguous array and
+    link to each other by 32-bit index rather than by pointer. Links
+    cost 8 bytes per element instead of 16, and nodes stay packed in
+    a handful of pages, so traversal misses the cache far less often.
+
+    Slot 0 is the sentinel. Erased slots are chained through their
+    next index and reused before the array grows. Iterators refer to
+    the list and a slot index, so they survive growth; references and
+    pointers to elements do not, unless capacity was reserved.
+
+    The array is only allocated on the first insertion.
+*/
+template <class T, class Allocator = std::allocator<T>>
+class IndexList {
+    public:
+    using index_type = std::uint32_t;
+
+    private:
+    struct Slot {
+        index_type next, prev;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* data() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+        using list_type         = IndexList;
+    private:
+        template <typename, typename>
+        friend class basic_iterator;
+        friend IndexList;
+
+        IndexList* list;
+        index_type index;
+
+        basic_iterator(const IndexList* list, index_type index) noexcept
+        : list{const_cast<IndexList*>(list)}, index{index} {}
+
+    public:
+        basic_iterator() : list{nullptr}, index{0} {};
+        basic_iterator(const basic_iterator&) = default;
+        basic_iterator(basic_iterator&&) = default;
+        ~basic_iterator() = default;
+        basic_iterator& operator=(const basic_iterator&) = default;
+        basic_iterator& operator=(basic_iterator&&) = default;
+
+        reference operator*() const {
+            return *(list->_slots[index].data());
+        }
+        pointer operator->() const {
+            return list->_slots[index].data();
+        }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            this->index = list->_slots[index].next;
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator temp = *this;
+            this->index = list->_slots[index].next;
+            return temp;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            this->index = list->_slots[index].prev;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator temp = *this;
+            this->index = list->_slots[index].prev;
+            return temp;
+        }
+
+        // Non-const iterators convert to const_iterator
+        template <typename P = pointer_type,
+                  typename = typename std::enable_if<!std::is_const<typename std::remove_pointer<P>::type>::value>::type>
+        operator basic_iterator<const T*, const T&>() const noexcept {
+            return basic_iterator<const T*, const T&>(list, index);
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept {
+            return this->index == other.index && this->list == other.list;
+        }
+        bool operator!=(const basic_iterator& other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+private:
+    // Slots are allocated through the user's allocator rebound to Slot
+    using slot_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using slot_traits         = std::allocator_traits<slot_allocator_type>;
+
+    // The sentinel and the end of the free chain share index 0
+    static constexpr index_type sentinel = 0;
+    static constexpr size_type max_slots = static_cast<index_type>(-1);
+
+    Slot* _slots;
+    index_type _capacity; // slots allocated, including the sentinel
+    index_type _used;     // slots ever handed out, including the sentinel
+    index_type _free;     // head of the chain of erased slots
+    size_type _size;
+    slot_allocator_type _alloc;
+
+    index_type first_index() const noexcept {
+        return _slots ? _slots[sentinel].next : sentinel;
+    }
+    index_type last_index() const noexcept {
+        return _slots ? _slots[sentinel].prev : sentinel;
+    }
+
+    // Move the live elements into an array of count slots
+    void reallocate(size_type count) {
+        reallocate(count, sentinel, [](Slot*) {});
+    }
+
+    // As above, but first build a new element at slot extra of the new array.
+    // Nothing has been moved yet, so its arguments may still refer to elements
+    template <typename Construct>
+    void reallocate(size_type count, index_type extra, Construct construct_extra) {
+        Slot* slots = slot_traits::allocate(_alloc, count);
+
+        if(_slots == nullptr)
+        {
+            ::new(static_cast<void*>(slots)) Slot;
+            slots[sentinel].next = sentinel;
+            slots[sentinel].prev = sentinel;
+            _used = 1;
+        }
+        else
+        {
+            for(index_type index = 0; index < _used; index++)
+            {
+                ::new(static_cast<void*>(slots + index)) Slot;
+                slots[index].next = _slots[index].next;
+                slots[index].prev = _slots[index].prev;
+            }
+        }
+
+        try
+        {
+            construct_extra(slots);
+        }
+        catch(...)
+        {
+            slot_traits::deallocate(_alloc, slots, count);
+            throw;
+        }
+
+        index_type moved = first_index();
+        try
+        {
+            for(; moved != sentinel; moved = _slots[moved].next)
+            {
+                ::new(static_cast<void*>(slots[moved].storage)) T(std::move_if_noexcept(*(_slots[moved].data())));
+            }
+        }
+        catch(...)
+        {
+            for(index_type index = first_index(); index != moved; index = _slots[index].next)
+            {
+                slots[index].data()->~T();
+            }
+            if(extra != sentinel)
+            {
+                slots[extra].data()->~T();
+            }
+            slot_traits::deallocate(_alloc, slots, count);
+            throw;
+        }
+
+        release_slots();
+        _slots = slots;
+        _capacity = static_cast<index_type>(count);
+    }
+
+    // Destroy every element, keeping the array
+    void destroy_elements() noexcept {
+        for(index_type index = first_index(); index != sentinel; index = _slots[index].next)
+        {
+            _slots[index].data()->~T();
+        }
+    }
+
+    // Destroy every element and return the array to the allocator
+    void release_slots() noexcept {
+        if(_slots != nullptr)
+        {
+            destroy_elements();
+            slot_traits::deallocate(_alloc, _slots, _capacity);
+        }
+    }
+
+    size_type grown_capacity() const {
+        if(_capacity == max_slots)
+        {
+            throw std::length_error("IndexList cannot address more elements");
+        }
+        size_type count = _capacity < 8 ? 16 : size_type(_capacity) * 2;
+        return count < max_slots ? count : max_slots;
+    }
+
+    // Construct an element from args in a free slot and link it in front of pos
+    template <typename... Args>
+    index_type link_slot(index_type pos, Args&&... args) {
+        index_type index;
+        if(_free != sentinel)
+        {
+            index = _free;
+            ::new(static_cast<void*>(_slots[index].storage)) T(std::forward<Args>(args)...);
+            _free = _slots[index].next;
+        }
+        else if(_used < _capacity)
+        {
+            index = _used;
+            ::new(static_cast<void*>(_slots + index)) Slot;
+            ::new(static_cast<void*>(_slots[index].storage)) T(std::forward<Args>(args)...);
+            _used++;
+        }
+        else
+        {
+            index = _slots ? _used : 1;
+            reallocate(grown_capacity(), index, [&](Slot* slots) {
+                ::new(static_cast<void*>(slots + index)) Slot;
+                ::new(static_cast<void*>(slots[index].storage)) T(std::forward<Args>(args)...);
+            });
+            _used++;
+        }
+
+        _slots[index].prev = _slots[pos].prev;
+        _slots[index].next = pos;
+        _slots[_slots[pos].prev].next = index;
+        _slots[pos].prev = index;
+        _size++;
+        return index;
+    }
+
+    // Unlink and destroy the element at index, chaining its slot for reuse
+    void unlink_slot(index_type index) noexcept {
+        _slots[_slots[index].prev].next = _slots[index].next;
+        _slots[_slots[index].next].prev = _slots[index].prev;
+        _slots[index].data()->~T();
+
+        _slots[index].next = _free;
+        _free = index;
+        _size--;
+    }
+
+    // Take over other's array, leaving other empty
+    void steal_slots(IndexList& other) noexcept {
+        _slots = other._slots;
+        _capacity = other._capacity;
+        _used = other._used;
+        _free = other._free;
+        _size = other._size;
+
+        other._slots = nullptr;
+        other._capacity = 0;
+        other._used = 0;
+        other._free = sentinel;
+        other._size = 0;
+    }
+
+public:
+    IndexList(): IndexList(Allocator()) {}
+    explicit IndexList( const Allocator& alloc )
+    : _slots(nullptr), _capacity(0), _used(0), _free(sentinel), _size(0), _alloc(alloc) {}
+    IndexList( size_type count, const T& value, const Allocator& alloc = Allocator() ): IndexList(alloc) {
+        reserve(count);
+        for(size_type index = 0; index < count; index++)
+        {
+            emplace_back(value);
+        }
+    }
+    explicit IndexList( size_type count, const Allocator& alloc = Allocator() ): IndexList(alloc) {
+        reserve(count);
+        for(size_type index = 0; index < count; index++)
+        {
+            emplace_back();
+        }
+    }
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    IndexList( InputIt first, InputIt last, const Allocator& alloc = Allocator() ): IndexList(alloc) {
+        if(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value)
+        {
+            reserve(std::distance(first, last));
+        }
+        for(; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+    IndexList( std::initializer_list<T> init, const Allocator& alloc = Allocator() )
+    : IndexList(init.begin(), init.end(), alloc) {}
+    IndexList( const IndexList& other )
+    : IndexList(other, slot_traits::select_on_container_copy_construction(other._alloc)) {}
+    IndexList( const IndexList& other, const Allocator& alloc ): IndexList(other.begin(), other.end(), alloc) {}
+    IndexList( IndexList&& other ) noexcept
+    : _slots(nullptr), _capacity(0), _used(0), _free(sentinel), _size(0), _alloc(std::move(other._alloc)) {
+        steal_slots(other);
+    }
+    ~IndexList() {
+        release_slots();
+    }
+
+    IndexList& operator=( const IndexList& other ) {
+        if(this != &other)
+        {
+            clear();
+            if(slot_traits::propagate_on_container_copy_assignment::value && _alloc != other._alloc)
+            {
+                // The array belongs to the allocator being replaced
+                release_slots();
+                _slots = nullptr;
+                _capacity = 0;
+                _used = 0;
+                _alloc = other._alloc;
+            }
+
+            reserve(other._size);
+            for(const_iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+            {
+                emplace_back(*currentSpot);
+            }
+        }
+        return *this;
+    }
+    IndexList& operator=( IndexList&& other ) noexcept(
+        slot_traits::propagate_on_container_move_assignment::value || slot_traits::is_always_equal::value) {
+        if(this != &other)
+        {
+            if(slot_traits::propagate_on_container_move_assignment::value || _alloc == other._alloc)
+            {
+                release_slots();
+                if(slot_traits::propagate_on_container_move_assignment::value)
+                {
+                    _alloc = std::move(other._alloc);
+                }
+                steal_slots(other);
+            }
+            else
+            {
+                // Our allocator cannot free other's array, so move element-wise
+                clear();
+                reserve(other._size);
+                for(iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+                {
+                    emplace_back(std::move(*currentSpot));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(_alloc);
+    }
+
+    reference front() {
+        return *(_slots[first_index()].data());
+    }
+    const_reference front() const {
+        return *(_slots[first_index()].data());
+    }
+
+    reference back() {
+        return *(_slots[last_index()].data());
+    }
+    const_reference back() const {
+        return *(_slots[last_index()].data());
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, first_index());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, first_index());
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(this, first_index());
+    }
+
+    iterator end() noexcept {
+        return iterator(this, sentinel);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, sentinel);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(this, sentinel);
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    size_type max_size() const noexcept {
+        return max_slots - 1;
+    }
+
+    // Elements that fit before the array has to grow
+    size_type capacity() const noexcept {
+        return _capacity > 0 ? _capacity - 1 : 0;
+    }
+
+    // Grow the array to hold count elements without reallocating
+    void reserve( size_type count ) {
+        if(count > max_size())
+        {
+            throw std::length_error("IndexList cannot address more elements");
+        }
+        if(count > capacity())
+        {
+            reallocate(count + 1);
+        }
+    }
+
+    // Destroy every element, keeping the array for reuse
+    void clear() noexcept {
+        if(_slots != nullptr)
+        {
+            destroy_elements();
+            _slots[sentinel].next = sentinel;
+            _slots[sentinel].prev = sentinel;
+            _used = 1;
+        }
+        _free = sentinel;
+        _size = 0;
+    }
+
+    iterator insert( const_iterator pos, const T& value ) {
+        return emplace(pos, value);
+    }
+    iterator insert( const_iterator pos, T&& value ) {
+        return emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    iterator emplace( const_iterator pos, Args&&... args ) {
+        return iterator(this, link_slot(pos.index, std::forward<Args>(args)...));
+    }
+
+    iterator erase( const_iterator pos ) {
+        index_type next = _slots[pos.index].next;
+        unlink_slot(pos.index);
+        return iterator(this, next);
+    }
+
+    void push_back( const T& value ) {
+        emplace_back(value);
+    }
+    void push_back( T&& value ) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    reference emplace_back( Args&&... args ) {
+        return *(_slots[link_slot(sentinel, std::forward<Args>(args)...)].data());
+    }
+
+    void pop_back() {
+        unlink_slot(last_index());
+    }
+
+    void push_front( const T& value ) {
+        emplace_front(value);
+    }
+    void push_front( T&& value ) {
+        emplace_front(std::move(value));
+    }
+
+    template <typename... Args>
+    reference emplace_front( Args&&... args ) {
+        return *(_slots[link_slot(first_index(), std::forward<Args>(args)...)].data());
+    }
+
+    void pop_front() {
+        unlink_slot(first_index());
+    }
+
+    // Exchange contents in O(1). Allocators are swapped only if they propagate
+    void swap( IndexList& other ) noexcept {
+        std::swap(_slots, other._slots);
+        std::swap(_capacity, other._capacity);
+        std::swap(_used, other._used);
+        std::swap(_free, other._free);
+        std::swap(_size, other._size);
+        if(slot_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+    }
+
+    /*
+        These do not need to be modified, they take advantage
+        of the const_iterator implementations above
+    */
+    iterator insert( iterator pos, const T & value ) {
+        return insert(const_iterator(pos), value);
+    }
+
+    iterator insert( iterator pos, T && value ) {
+        return insert(const_iterator(pos), std::move(value));
+    }
+
+    iterator erase( iterator pos ) {
+        return erase(const_iterator(pos));
+    }
+};
+
+template <class T, class Allocator>
+void swap(IndexList<T, Allocator>& lhs, IndexList<T, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
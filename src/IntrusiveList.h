@@ -0,0 +1,354 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstring> // std::memcpy
+#include <iterator> // std::bidirectional_iterator_tag
+#include <type_traits> // std::is_same, std::enable_if
+#include <utility> // std::swap
+
+#include "ListHook.h" // ListHook
+#include "IteratorComparisons.h" // const/non-const iterator comparisons
+
+/*
+    A doubly linked list threaded through objects the caller already
+    owns. Each element embeds a ListHook member which holds its links,
+    so insert and erase never allocate or copy and an element can be
+    erased in O(1) from a reference to it.
+
+    The list never owns its elements: they must outlive their time in
+    the list, and an object can be on at most one list per hook.
+
+    Example:
+    {
+        struct Job {
+            int id;
+            ListHook hook;
+        };
+
+        Job a{1}, b{2};
+        IntrusiveList<Job, &Job::hook> jobs;
+
+        jobs.push_back(a);
+        jobs.push_back(b);
+        jobs.erase(a);
+
+        std::cout << jobs.front().id << std::endl; // 2
+    }
+*/
+template <class T, ListHook T::*Hook>
+class IntrusiveList {
+    private:
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+        using list_type         = IntrusiveList;
+    private:
+        template <typename, typename>
+        friend class basic_iterator;
+        friend IntrusiveList;
+
+        ListHook* node;
+
+        explicit basic_iterator(ListHook* ptr) noexcept : node{ptr} {}
+        explicit basic_iterator(const ListHook* ptr) noexcept : node{const_cast<ListHook*>(ptr)} {}
+
+    public:
+        basic_iterator() {node = nullptr;};
+        basic_iterator(const basic_iterator&) = default;
+        basic_iterator(basic_iterator&&) = default;
+        ~basic_iterator() = default;
+        basic_iterator& operator=(const basic_iterator&) = default;
+        basic_iterator& operator=(basic_iterator&&) = default;
+
+        reference operator*() const {
+            return *owner(this->node);
+        }
+        pointer operator->() const {
+            return owner(this->node);
+        }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            this->node = this->node->next;
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            ListHook* temp = this->node;
+            this->node = this->node->next;
+            return basic_iterator(temp);
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            this->node = this->node->prev;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            ListHook* temp = this->node;
+            this->node = this->node->prev;
+            return basic_iterator(temp);
+        }
+
+        // Non-const iterators convert to const_iterator
+        template <typename P = pointer_type,
+                  typename = typename std::enable_if<!std::is_const<typename std::remove_pointer<P>::type>::value>::type>
+        operator basic_iterator<const T*, const T&>() const noexcept {
+            return basic_iterator<const T*, const T&>(node);
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept {
+            return this->node == other.node;
+        }
+        bool operator!=(const basic_iterator& other) const noexcept {
+            return this->node != other.node;
+        }
+    };
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+private:
+    ListHook head, tail;
+    size_type _size;
+
+    // Byte offset of the hook within T
+    static const ptrdiff_t hook_offset;
+
+    // Read the offset out of the member pointer itself, which the
+    // Itanium C++ ABI represents as exactly that, so no T is needed
+    static ptrdiff_t member_offset() noexcept {
+        static_assert(sizeof(Hook) == sizeof(ptrdiff_t), "pointers to data members must hold a plain offset");
+        ListHook T::*hook = Hook;
+        ptrdiff_t offset;
+        std::memcpy(&offset, &hook, sizeof(offset));
+        return offset;
+    }
+
+    // The element a hook is embedded in
+    static T* owner(ListHook* hook) noexcept {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - hook_offset);
+    }
+
+    static ListHook* hook_of(T& value) noexcept {
+        return &(value.*Hook);
+    }
+
+    // Take over other's elements, leaving other empty
+    void steal_nodes(IntrusiveList& other) noexcept {
+        _size = other._size;
+        if(_size > 0)
+        {
+            head.next = other.head.next;
+            tail.prev = other.tail.prev;
+            head.prev = &tail;
+            tail.next = &head;
+
+            head.next->prev = &head;
+            tail.prev->next = &tail;
+        }
+        else
+        {
+            ListHook::reset(head, tail);
+        }
+
+        ListHook::reset(other.head, other.tail);
+        other._size = 0;
+    }
+
+    // Detach hook and mark it unlinked
+    void unlink(ListHook* hook) noexcept {
+        ListHook::unlink(hook);
+        hook->next = nullptr;
+        hook->prev = nullptr;
+        _size--;
+    }
+
+public:
+    IntrusiveList() noexcept : head{}, tail{}, _size{0} {
+        ListHook::reset(head, tail);
+    }
+
+    // Elements live elsewhere, so a list cannot be copied, only moved
+    IntrusiveList( const IntrusiveList& other ) = delete;
+    IntrusiveList& operator=( const IntrusiveList& other ) = delete;
+
+    IntrusiveList( IntrusiveList&& other ) noexcept : head{}, tail{}, _size{0} {
+        steal_nodes(other);
+    }
+
+    IntrusiveList& operator=( IntrusiveList&& other ) noexcept {
+        if(this != &other)
+        {
+            clear();
+            steal_nodes(other);
+        }
+        return *this;
+    }
+
+    // Unlinks every element; none are destroyed
+    ~IntrusiveList() {
+        clear();
+    }
+
+    reference front() {
+        return *owner(head.next);
+    }
+    const_reference front() const {
+        return *owner(head.next);
+    }
+
+    reference back() {
+        return *owner(tail.prev);
+    }
+    const_reference back() const {
+        return *owner(tail.prev);
+    }
+
+    iterator begin() noexcept {
+        return iterator(head.next);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(head.next);
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(head.next);
+    }
+
+    iterator end() noexcept {
+        return iterator(&tail);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(&tail);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(&tail);
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    // An iterator to an element already on this list, in O(1)
+    iterator iterator_to( reference value ) noexcept {
+        return iterator(hook_of(value));
+    }
+    const_iterator iterator_to( const_reference value ) const noexcept {
+        return const_iterator(&(value.*Hook));
+    }
+
+    void clear() noexcept {
+        while(_size > 0)
+        {
+            unlink(head.next);
+        }
+    }
+
+    // Link value, which must not be on a list, in front of pos
+    iterator insert( const_iterator pos, reference value ) noexcept {
+        ListHook* insertedNode = hook_of(value);
+        ListHook::link_before(pos.node, insertedNode);
+        _size++;
+        return iterator(insertedNode);
+    }
+
+    iterator erase( const_iterator pos ) noexcept {
+        iterator temp(pos.node->next);
+        unlink(pos.node);
+        return temp;
+    }
+
+    // Unlink value, which must be on this list, in O(1)
+    iterator erase( reference value ) noexcept {
+        return erase(iterator_to(value));
+    }
+
+    void push_back( reference value ) noexcept {
+        insert(end(), value);
+    }
+
+    void pop_back() noexcept {
+        unlink(tail.prev);
+    }
+
+    void push_front( reference value ) noexcept {
+        insert(begin(), value);
+    }
+
+    void pop_front() noexcept {
+        unlink(head.next);
+    }
+
+    // Move every element of other in front of pos in O(1)
+    void splice( const_iterator pos, IntrusiveList& other ) noexcept {
+        if(this == &other || other._size == 0)
+        {
+            return;
+        }
+
+        ListHook::transfer(pos.node, other.head.next, &(other.tail));
+        _size += other._size;
+        other._size = 0;
+    }
+
+    // Move the element at it from other in front of pos in O(1)
+    void splice( const_iterator pos, IntrusiveList& other, const_iterator it ) noexcept {
+        if(pos.node == it.node || pos.node == it.node->next)
+        {
+            return;
+        }
+
+        ListHook::transfer(pos.node, it.node, it.node->next);
+        _size++;
+        other._size--;
+    }
+
+    // Exchange contents in O(1)
+    void swap( IntrusiveList& other ) noexcept {
+        if(this == &other)
+        {
+            return;
+        }
+
+        IntrusiveList temp(std::move(other));
+        other.steal_nodes(*this);
+        steal_nodes(temp);
+    }
+
+    /*
+        These do not need to be modified, they take advantage
+        of the const_iterator implementations above
+    */
+    iterator insert( iterator pos, reference value ) noexcept {
+        return insert(const_iterator(pos), value);
+    }
+
+    iterator erase( iterator pos ) noexcept {
+        return erase(const_iterator(pos));
+    }
+};
+
+template <class T, ListHook T::*Hook>
+const ptrdiff_t IntrusiveList<T, Hook>::hook_offset = IntrusiveList<T, Hook>::member_offset();
+
+template <class T, ListHook T::*Hook>
+void swap(IntrusiveList<T, Hook>& lhs, IntrusiveList<T, Hook>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <type_traits> // std::is_same, std::enable_if
+
+/*
+    You do not need to modify these methods!
+
+    These method provide a overload to compare const and
+    non-const iterators safely.
+*/
+
+namespace {
+    template<typename Iter, typename ConstIter, typename T>
+    using enable_for_list_iters = typename std::enable_if<
+        std::is_same<
+            typename Iter::list_type::iterator,
+            Iter
+        >{} && std::is_same<
+            typename Iter::list_type::const_iterator,
+            ConstIter
+        >{}, T>::type;
+}
+
+template<typename Iterator, typename ConstIter>
+enable_for_list_iters<Iterator, ConstIter, bool> operator==(const Iterator & lhs, const ConstIter & rhs) {
+    return (const ConstIter &)(lhs) == rhs;
+}
+
+template<typename Iterator, typename ConstIter>
+enable_for_list_iters<Iterator, ConstIter, bool> operator==(const ConstIter & lhs, const Iterator & rhs) {
+    return (const ConstIter &)(rhs) == lhs;
+}
+
+template<typename Iterator, typename ConstIter>
+enable_for_list_iters<Iterator, ConstIter, bool> operator!=(const Iterator & lhs, const ConstIter & rhs) {
+    return (const ConstIter &)(lhs) != rhs;
+}
+
+template<typename Iterator, typename ConstIter>
+enable_for_list_iters<Iterator, ConstIter, bool> operator!=(const ConstIter & lhs, const Iterator & rhs) {
+    return (const ConstIter &)(rhs) != lhs;
+}
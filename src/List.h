@@ -1,23 +1,39 @@
 #pragma once
 
 #include <cstddef> // size_t
+#include <functional> // std::less
+#include <initializer_list> // std::initializer_list
+#include <stdexcept> // std::out_of_range
 #include <iterator> // std::bidirectional_iterator_tag
+#include <memory> // std::allocator, std::allocator_traits
 #include <type_traits> // std::is_same, std::enable_if
+#include <utility> // std::move, std::forward, std::swap, std::in_place
 
-template <class T>
-class List {
+#include "IteratorComparisons.h" // const/non-const iterator comparisons
+#include "ListHook.h" // ListHook
+#include "NodeLayout.h" // pointers_first_layout
+#include "PositionIndex.h" // no_index
+#include "PrefetchingIterator.h" // prefetch_read, default_prefetch_distance
+
+template <class T, class Allocator = std::allocator<T>, class Layout = pointers_first_layout, class Index = no_index>
+class List : private Index::tree {
     private:
-    struct Node {
-        Node *next, *prev;
-        T data;
-        explicit Node(Node* prev = nullptr, Node* next = nullptr)
-        : next{next}, prev{prev} {}
-        explicit Node(const T& data, Node* prev = nullptr, Node* next = nullptr)
-        : next{next}, prev{prev}, data{data} {}
-        explicit Node(T&& data, Node* prev = nullptr, Node* next = nullptr)
-        : next{next}, prev{prev}, data{std::move(data)} {}
+    // Links shared by the payload-free sentinels and the data nodes
+    using NodeBase = ListHook;
+
+    // Header of a block of nodes allocated together by a bulk constructor.
+    // The block is freed once every node carved from it has been released
+    struct Slab {
+        size_t live;
+        size_t capacity;
     };
 
+    // Links, extended with whatever per-node state Index keeps (see PositionIndex.h)
+    using IndexHook = typename Index::template hook<NodeBase>;
+
+    // Links, element and owning slab, arranged by Layout (see NodeLayout.h)
+    using Node = typename Layout::template node<IndexHook, Slab, T>;
+
     template <typename pointer_type, typename reference_type>
     class basic_iterator {
     public:
@@ -26,14 +42,18 @@ class List {
         using difference_type   = ptrdiff_t;
         using pointer           = pointer_type;
         using reference         = reference_type;
+        using list_type         = List;
     private:
-        friend class List<value_type>;
-        using Node = typename List<value_type>::Node;
+        template <typename, typename>
+        friend class basic_iterator;
+        friend List;
+        using Node = typename List::Node;
+        using NodeBase = typename List::NodeBase;
 
-        Node* node;
+        NodeBase* node;
 
-        explicit basic_iterator(Node* ptr) noexcept : node{ptr} {}
-        explicit basic_iterator(const Node* ptr) noexcept : node{const_cast<Node*>(ptr)} {}
+        explicit basic_iterator(NodeBase* ptr) noexcept : node{ptr} {}
+        explicit basic_iterator(const NodeBase* ptr) noexcept : node{const_cast<NodeBase*>(ptr)} {}
 
     public:
         basic_iterator() {node = nullptr;};
@@ -44,10 +64,10 @@ class List {
         basic_iterator& operator=(basic_iterator&&) = default;
 
         reference operator*() const {
-            return this->node->data;
+            return static_cast<Node*>(this->node)->data;
         }
         pointer operator->() const {
-            T* temp = &(this->node->data);
+            T* temp = &(static_cast<Node*>(this->node)->data);
             return temp;
         }
 
@@ -58,7 +78,7 @@ class List {
         }
         // Postfix Increment: a++
         basic_iterator operator++(int) {
-            Node* temp = this->node;
+            NodeBase* temp = this->node;
             this->node = this->node->next;
             return basic_iterator(temp);
         }
@@ -69,11 +89,18 @@ class List {
         }
         // Postfix Decrement: a--
         basic_iterator operator--(int) {
-            Node* temp = this->node;
+            NodeBase* temp = this->node;
             this->node = this->node->prev;
             return basic_iterator(temp);
         }
 
+        // Non-const iterators convert to const_iterator
+        template <typename P = pointer_type,
+                  typename = typename std::enable_if<!std::is_const<typename std::remove_pointer<P>::type>::value>::type>
+        operator basic_iterator<const T*, const T&>() const noexcept {
+            return basic_iterator<const T*, const T&>(node);
+        }
+
         bool operator==(const basic_iterator& other) const noexcept {
             return this->node == other.node;
         }
@@ -84,6 +111,9 @@ class List {
 
 public:
     using value_type      = T;
+    using allocator_type  = Allocator;
+    using layout_type     = Layout;
+    using index_type      = Index;
     using size_type       = size_t;
     using difference_type = ptrdiff_t;
     using reference       = value_type&;
@@ -93,86 +123,367 @@ public:
     using iterator        = basic_iterator<pointer, reference>;
     using const_iterator  = basic_iterator<const_pointer, const_reference>;
 
+    // Bytes of storage each element's node occupies
+    static constexpr size_type node_size = sizeof(Node);
+
+    // Maximum number of nodes bulk constructors carve from one allocation
+    static constexpr size_type slab_capacity = sizeof(Node) < 1024 ? 16384 / sizeof(Node) : 16;
+    static_assert(slab_capacity < (size_type(1) << (8 * sizeof(slab_index_type))), "slab indexes must fit in slab_index_type");
+
+    // Fewest nodes worth a slab: smaller remainders are allocated one by one
+    // rather than spend a header slot on them
+    static constexpr size_type min_slab_nodes = 4;
+
 private:
-    Node head, tail;
+    // Nodes are allocated through the user's allocator rebound to Node
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits         = std::allocator_traits<node_allocator_type>;
+
+    // Storage of a destroyed node waiting on the free list
+    struct FreeNode {
+        FreeNode* next;
+        Slab* slab;
+    };
+
+    NodeBase head, tail;
     size_type _size;
+    node_allocator_type _alloc;
 
-public:
-    List(): head(0), tail(0), _size(0){
-        head.next = &tail;
-        head.prev = &tail;
-        tail.next = &head;
-        tail.prev = &head;
+    // Node recycling: up to _cache_limit freed nodes are kept for reuse
+    FreeNode* _free_nodes;
+    size_type _free_count;
+    size_type _cache_limit;
+
+    // Positional index over the data nodes. Held as a base so an empty
+    // policy such as no_index adds nothing to sizeof(List)
+    using IndexTree = typename Index::tree;
+
+    IndexTree& index_tree() noexcept {
+        return *this;
+    }
+    const IndexTree& index_tree() const noexcept {
+        return *this;
     }
-    List( size_type count, const T& value ): head(0), tail(0), _size(count) {
-        Node *prevNode, *currentNode;
 
-        head.next = &tail;
-        head.prev = &tail;
-        tail.next = &head;
-        tail.prev = &head;
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* node;
+        Slab* slab = nullptr;
+        if(_free_nodes != nullptr)
+        {
+            node = reinterpret_cast<Node*>(_free_nodes);
+            slab = _free_nodes->slab;
+            _free_nodes = _free_nodes->next;
+            _free_count--;
+        }
+        else
+        {
+            node = node_traits::allocate(_alloc, 1);
+        }
 
-        if(count > 0)
+        construct_node(node, slab, std::forward<Args>(args)...);
+        return node;
+    }
+
+    // Construct a node in storage, returning the storage if T's constructor throws
+    template <typename... Args>
+    void construct_node(Node* node, Slab* slab, Args&&... args) {
+        try {
+            node_traits::construct(_alloc, node, std::in_place, slab, std::forward<Args>(args)...);
+        }
+        catch(...) {
+            release_storage(node, slab);
+            throw;
+        }
+    }
+
+    void destroy_node(Node* node) noexcept {
+        Slab* slab = node->slab();
+        node_traits::destroy(_alloc, node);
+        release_storage(node, slab);
+    }
+
+    // Park the storage of a destroyed node on the free list, or free it once the cache is full
+    void release_storage(Node* node, Slab* slab) noexcept {
+        if(_free_count < _cache_limit)
         {
-            prevNode = &head;
+            _free_nodes = ::new(static_cast<void*>(node)) FreeNode{_free_nodes, slab};
+            _free_count++;
+        }
+        else
+        {
+            deallocate_storage(node, slab);
+        }
+    }
+
+    // Return node storage to the allocator. Slab nodes only free their slab once it is empty
+    void deallocate_storage(Node* node, Slab* slab) noexcept {
+        if(slab == nullptr)
+        {
+            node_traits::deallocate(_alloc, node, 1);
+        }
+        else if(--slab->live == 0)
+        {
+            node_traits::deallocate(_alloc, reinterpret_cast<Node*>(slab), slab->capacity + 1);
+        }
+    }
+
+    // Deallocate cached nodes until at most keep remain
+    void trim_cache(size_type keep) noexcept {
+        while(_free_count > keep)
+        {
+            FreeNode* freed = _free_nodes;
+            _free_nodes = freed->next;
+            _free_count--;
+            deallocate_storage(reinterpret_cast<Node*>(freed), freed->slab);
+        }
+    }
 
-            for(size_t num = 0; num < count; num++)
+    // Append count nodes laid out contiguously in traversal order, using as
+    // few allocations as possible. construct(node, slab) builds each node
+    template <typename Construct>
+    void append_slabs(size_type count, Construct construct) {
+        // Indexing a large append node by node costs more than a rebuild
+        const bool reindex = count > _size;
+        if(reindex)
+        {
+            index_tree().invalidate();
+        }
+
+        // Chain the nodes privately after the last one, then link and count them once
+        NodeBase* last = tail.prev;
+        size_type appended = 0;
+        try {
+            // Reuse cached nodes before allocating any
+            for(; count > 0 && _free_nodes != nullptr; count--, appended++)
+            {
+                Node* node = reinterpret_cast<Node*>(_free_nodes);
+                Slab* slab = _free_nodes->slab;
+                _free_nodes = _free_nodes->next;
+                _free_count--;
+                construct(node, slab);
+                chain_after(last, node);
+            }
+
+            while(count >= min_slab_nodes)
             {
-                currentNode = new Node(value);
-                currentNode->prev = prevNode;
-                prevNode->next = currentNode;
-                prevNode = currentNode;
+                size_type batch = count < slab_capacity ? count : slab_capacity;
+
+                // The header occupies the first node-sized slot of the block
+                static_assert(sizeof(Slab) <= sizeof(Node), "Slab header must fit in a node slot");
+                Node* block = node_traits::allocate(_alloc, batch + 1);
+                Slab* slab = ::new(static_cast<void*>(block)) Slab{0, batch};
+
+                for(size_type index = 1; index <= batch; index++, appended++)
+                {
+                    // Count the slot first so a throwing constructor can hand it back
+                    slab->live++;
+                    construct(block + index, slab);
+                    chain_after(last, block + index);
+                }
+                count -= batch;
             }
-            currentNode->next = &tail;
-            tail.prev = currentNode;
+
+            // Too few nodes left to pay for a slab's header slot: allocate them singly
+            for(; count > 0; count--, appended++)
+            {
+                Node* node = node_traits::allocate(_alloc, 1);
+                construct(node, nullptr);
+                chain_after(last, node);
+            }
+        }
+        catch(...) {
+            // Keep the elements built so far
+            link_appended(last, appended, reindex);
+            throw;
         }
+        link_appended(last, appended, reindex);
     }
-    explicit List( size_type count ): head(0), tail(0), _size(count){
-        Node *prevNode, *currentNode;
 
-        head.next = &tail;
-        head.prev = &tail;
-        tail.next = &head;
-        tail.prev = &head;
+    // Hang node after last in a chain that is not linked into the list yet
+    static void chain_after(NodeBase*& last, NodeBase* node) noexcept {
+        node->prev = last;
+        last->next = node;
+        last = node;
+    }
 
-        if(count > 0)
+    // Close the chain append_slabs built after tail.prev, ending at last
+    void link_appended(NodeBase* last, size_type appended, bool reindex) noexcept {
+        if(appended == 0)
+        {
+            return;
+        }
+
+        NodeBase* first = tail.prev->next;
+        last->next = &tail;
+        tail.prev = last;
+        _size += appended;
+        if(!reindex)
+        {
+            index_appended(first);
+        }
+    }
+
+    // Unlink the count nodes in front of last in one step, then destroy them
+    void drop_front(NodeBase* last, size_type count) noexcept {
+        if(count == 0)
         {
-            prevNode = &head;
+            return;
+        }
 
-            for(size_t num = 0; num < count; num++)
+        NodeBase* currentNode = head.next;
+        if(count == _size)
+        {
+            index_tree().reset();
+        }
+        else if(count > _size - count)
+        {
+            index_tree().invalidate();
+        }
+        else if(Index::positional)
+        {
+            for(NodeBase* node = currentNode; node != last; node = node->next)
             {
-                currentNode = new Node(T{});
-                currentNode->prev = prevNode;
-                prevNode->next = currentNode;
-                prevNode = currentNode;
+                index_tree().erased(node);
             }
-            currentNode->next = &tail;
-            tail.prev = currentNode;
         }
 
+        head.next = last;
+        last->prev = &head;
+        _size -= count;
+
+        while(currentNode != last)
+        {
+            NodeBase* nextNode = currentNode->next;
+            destroy_node(static_cast<Node*>(currentNode));
+            currentNode = nextNode;
+        }
     }
-    List( const List& other ): head(0), tail(0), _size(other._size) {
-        Node *prevNode, *currentNode;
 
-        head.next = &tail;
-        head.prev = &tail;
-        tail.next = &head;
-        tail.prev = &head;
+    // Take over other's cached nodes. Both lists must share an allocator
+    void steal_cache(List& other) noexcept {
+        _free_nodes = other._free_nodes;
+        _free_count = other._free_count;
+        _cache_limit = other._cache_limit;
+
+        other._free_nodes = nullptr;
+        other._free_count = 0;
+    }
 
-        iterator currentSpot = iterator(other.head.next);
-        prevNode = &head;
-        while(currentSpot != other.end())
+    // Call f on each element of [first, last) while a lead pointer runs
+    // Distance nodes ahead. Each step of the lead reads the node it
+    // prefetched one element earlier and prefetches the next without
+    // touching it, so every miss overlaps with f on the current element
+    template <size_t Distance, typename Function>
+    static void visit(NodeBase* first, const NodeBase* last, Function&& f) {
+        NodeBase* lead = first;
+        for(size_t i = 0; i < Distance && lead != last; i++)
         {
-            currentNode = new Node(*currentSpot);
-            currentNode->prev = prevNode;
-            prevNode->next = currentNode;
-            prevNode = currentNode;
-            currentSpot++;
+            lead = lead->next;
+        }
+
+        for(NodeBase* currentNode = first; currentNode != last; currentNode = currentNode->next)
+        {
+            if(Distance > 0 && lead != last)
+            {
+                lead = lead->next;
+                prefetch_read(lead);
+            }
+            f(static_cast<Node*>(currentNode)->data);
+        }
+    }
+
+    // Report a node just linked into the list to the index
+    void index_inserted(NodeBase* node) noexcept {
+        index_tree().inserted(node, node->prev != &head ? node->prev : nullptr, node->next != &tail ? node->next : nullptr);
+    }
+
+    // Report the nodes from first to the end of the list, just appended
+    void index_appended(NodeBase* first) noexcept {
+        if(Index::positional)
+        {
+            for(; first != &tail; first = first->next)
+            {
+                index_inserted(first);
+            }
+        }
+    }
+
+    // The node at position pos, or the end sentinel for any pos >= size()
+    NodeBase* node_at(size_type pos) const noexcept {
+        if(pos >= _size)
+        {
+            return const_cast<NodeBase*>(&tail);
+        }
+        index_tree().refresh(head.next, &tail);
+        return index_tree().select(pos);
+    }
+
+    // Point the sentinels at each other
+    void reset_sentinels() noexcept {
+        NodeBase::reset(head, tail);
+    }
+
+    // Link a node constructed from args in front of pos
+    template <typename... Args>
+    Node* link_node(NodeBase* pos, Args&&... args) {
+        Node* insertedNode = create_node(std::forward<Args>(args)...);
+        NodeBase::link_before(pos, insertedNode);
+        _size++;
+        index_inserted(insertedNode);
+        return insertedNode;
+    }
+
+    // Append a node created from args to the end of the list
+    template <typename... Args>
+    void append_node(Args&&... args) {
+        link_node(&tail, std::forward<Args>(args)...);
+    }
+
+    // Append [first, last). Single-pass ranges cannot be measured up front,
+    // so their nodes are allocated one at a time
+    template <typename InputIt>
+    void append_range(InputIt first, InputIt last, std::input_iterator_tag) {
+        for(; first != last; ++first)
+        {
+            append_node(*first);
+        }
+    }
+    template <typename ForwardIt>
+    void append_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+        append_slabs(std::distance(first, last), [&](Node* node, Slab* slab) {
+            construct_node(node, slab, *first);
+            ++first;
+        });
+    }
+
+    // Assign [first, last) over the existing elements, then append or erase the rest
+    template <typename InputIt, typename Tag>
+    void assign_range(InputIt first, InputIt last, Tag tag) {
+        iterator currentSpot = begin();
+        for(; currentSpot != end() && first != last; currentSpot++, ++first)
+        {
+            *currentSpot = *first;
+        }
+
+        if(first != last)
+        {
+            append_range(first, last, tag);
         }
-        currentNode->next = &tail;
-        tail.prev = currentNode;
+        else
+        {
+            erase(currentSpot, end());
+        }
+    }
+
+    // Relink the nodes in [first, last) in front of pos
+    static void transfer(NodeBase* pos, NodeBase* first, NodeBase* last) noexcept {
+        NodeBase::transfer(pos, first, last);
     }
-    List( List&& other ): head(0), tail(0), _size(other._size) {
+
+    // Take ownership of other's nodes. Both lists must share an allocator
+    void steal_nodes(List& other) noexcept {
+        _size = other._size;
         if(_size > 0)
         {
             head.next = other.head.next;
@@ -185,101 +496,172 @@ public:
         }
         else
         {
-            head.next = &tail;
-            head.prev = &tail;
-            tail.next = &head;
-            tail.prev = &head;
+            reset_sentinels();
         }
-        
+
+        index_tree() = other.index_tree();
+
         //Set old linked list to empty state
-        other.head.next = other.head.prev = &(other.tail);
-        other.tail.next = other.tail.prev = &(other.head);
+        other.reset_sentinels();
         other._size = 0;
+        other.index_tree().reset();
+    }
 
+public:
+    List(): List(Allocator()) {}
+    explicit List( const Allocator& alloc )
+    : head(), tail(), _size(0), _alloc(alloc), _free_nodes(nullptr), _free_count(0), _cache_limit(0) {
+        reset_sentinels();
     }
-    ~List() {
-        Node *prevNode, *currentNode = head.next;
-        while(currentNode != &tail)
+    /*
+      The bulk constructors below carve their nodes from a few large
+      slabs laid out in traversal order rather than allocating each one.
+    */
+    List( size_type count, const T& value, const Allocator& alloc = Allocator() ): List(alloc) {
+        append_slabs(count, [&](Node* node, Slab* slab) {
+            construct_node(node, slab, value);
+        });
+    }
+    explicit List( size_type count, const Allocator& alloc = Allocator() ): List(alloc) {
+        append_slabs(count, [&](Node* node, Slab* slab) {
+            construct_node(node, slab);
+        });
+    }
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    List( InputIt first, InputIt last, const Allocator& alloc = Allocator() ): List(alloc) {
+        append_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+    List( std::initializer_list<T> init, const Allocator& alloc = Allocator() ): List(init.begin(), init.end(), alloc) {}
+    List( const List& other )
+    : List(other, node_traits::select_on_container_copy_construction(other._alloc)) {}
+    List( const List& other, const Allocator& alloc ): List(alloc) {
+        _cache_limit = other._cache_limit;
+        append_range(other.begin(), other.end(), std::forward_iterator_tag());
+    }
+    List( List&& other )
+    : head(), tail(), _size(0), _alloc(std::move(other._alloc)), _free_nodes(nullptr), _free_count(0), _cache_limit(0) {
+        steal_nodes(other);
+        steal_cache(other);
+    }
+    List( List&& other, const Allocator& alloc ): List(alloc) {
+        _cache_limit = other._cache_limit;
+        if(_alloc == other._alloc)
         {
-            prevNode = currentNode;
-            currentNode = currentNode->next;
-            delete prevNode;
+            steal_nodes(other);
         }
-        head.next = &tail;
-        tail.prev = &head;
-
+        else
+        {
+            // Nodes cannot change allocators, so move the elements instead
+            for(iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+            {
+                append_node(std::move(*currentSpot));
+            }
+            other.clear();
+        }
+    }
+    ~List() {
+        _cache_limit = 0;
+        clear();
+        trim_cache(0);
     }
+    // Copy assignment reuses existing nodes, assigning into their data, and
+    // only allocates or frees the difference in size
     List& operator=( const List& other ) {
-        Node *prevNode, *currentNode;
         if(this != &other)
         {
-            this->~List();
-            this->_size = other._size;
-            
-            iterator currentSpot = iterator(other.head.next);
-            prevNode = &(this->head);
-            while(currentSpot != other.end())
+            if(node_traits::propagate_on_container_copy_assignment::value && _alloc != other._alloc)
             {
-                currentNode = new Node(*currentSpot);
-                currentNode->prev = prevNode;
-                prevNode->next = currentNode;
-                prevNode = currentNode;
-                currentSpot++;
+                // Nodes and cached nodes belong to the allocator being replaced
+                clear();
+                trim_cache(0);
+                _alloc = other._alloc;
             }
-            currentNode->next = &(this->tail);
-            this->tail.prev = currentNode;
+
+            assign_range(other.begin(), other.end(), std::forward_iterator_tag());
         }
         return *this;
     }
-    List& operator=( List&& other ) noexcept {
+    List& operator=( std::initializer_list<T> init ) {
+        assign(init);
+        return *this;
+    }
+    List& operator=( List&& other ) noexcept(
+        node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value) {
         if(this != &other)
         {
-            this->~List();
-            this->_size = other._size;
-            if(_size > 0)
+            clear();
+            if(node_traits::propagate_on_container_move_assignment::value)
             {
-                this->head.next = other.head.next;
-                this->head.prev = &(this->tail);
-                this->tail.next = &(this->head);
-                this->tail.prev = other.tail.prev;
+                trim_cache(0);
+                _alloc = std::move(other._alloc);
+            }
 
-                this->head.next->prev = &(this->head);
-                this->tail.prev->next = &(this->tail);
+            if(node_traits::propagate_on_container_move_assignment::value || _alloc == other._alloc)
+            {
+                steal_nodes(other);
             }
             else
             {
-                this->head.next = &(this->tail);
-                this->head.prev = &(this->tail);
-                this->tail.next = &(this->head);
-                this->tail.prev = &(this->head);
+                // Our allocator cannot free other's nodes, so move element-wise
+                for(iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+                {
+                    append_node(std::move(*currentSpot));
+                }
+                other.clear();
             }
-            
-            //Set old linked list to empty state
-            other.head.next = other.head.prev = &(other.tail);
-            other.tail.next = other.tail.prev = &(other.head);
-            other._size = 0;
         }
         return *this;
     }
 
+    // Replace the contents, reusing existing nodes where possible
+    void assign( size_type count, const T& value ) {
+        iterator currentSpot = begin();
+        for(; currentSpot != end() && count > 0; currentSpot++, count--)
+        {
+            *currentSpot = value;
+        }
+
+        if(count > 0)
+        {
+            append_slabs(count, [&](Node* node, Slab* slab) {
+                construct_node(node, slab, value);
+            });
+        }
+        else
+        {
+            erase(currentSpot, end());
+        }
+    }
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign( InputIt first, InputIt last ) {
+        assign_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+    void assign( std::initializer_list<T> init ) {
+        assign_range(init.begin(), init.end(), std::forward_iterator_tag());
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(_alloc);
+    }
+
     reference front() {
-        reference front = head.next->data;
+        reference front = static_cast<Node*>(head.next)->data;
         return front;
     }
     const_reference front() const {
-        const_reference front = head.next->data;
+        const_reference front = static_cast<Node*>(head.next)->data;
         return front;
     }
-	
+
     reference back() {
-        reference back = tail.prev->data;
+        reference back = static_cast<Node*>(tail.prev)->data;
         return back;
     }
     const_reference back() const {
-        const_reference back = tail.prev->data;
+        const_reference back = static_cast<Node*>(tail.prev)->data;
         return back;
     }
-	
+
     iterator begin() noexcept {
         if(_size == 0)
         {
@@ -312,6 +694,27 @@ public:
         return const_iterator(&tail);
     }
 
+    /*
+      Call f on every element in order, prefetching the node Distance
+      hops ahead of the one being visited. Returns f, as std::for_each
+      does. Distance 0 walks the list without prefetching.
+
+      Nodes are only reachable through their predecessors, so the lead
+      can fetch one new node per element: prefetching hides up to one
+      miss behind each call of f, and a larger Distance only gives the
+      prefetched lines more time to land before f reads them.
+    */
+    template <size_t Distance = default_prefetch_distance, typename Function>
+    Function for_each( Function f ) {
+        visit<Distance>(head.next, &tail, f);
+        return f;
+    }
+    template <size_t Distance = default_prefetch_distance, typename Function>
+    Function for_each( Function f ) const {
+        visit<Distance>(head.next, &tail, [&](T& value) { f(static_cast<const T&>(value)); });
+        return f;
+    }
+
     bool empty() const noexcept {
         if(_size == 0)
         {
@@ -324,162 +727,419 @@ public:
         return _size;
     }
 
+    /*
+      Positional access, available when Index is a positional policy such
+      as order_statistic_index. Each call takes O(log n) expected time,
+      plus an O(n) rebuild after a bulk relink (sort, range splice, large
+      append) left the index stale.
+    */
+    reference at( size_type pos ) {
+        static_assert(Index::positional, "List::at needs a positional Index policy");
+        if(pos >= _size)
+        {
+            throw std::out_of_range("List::at");
+        }
+        return static_cast<Node*>(node_at(pos))->data;
+    }
+    const_reference at( size_type pos ) const {
+        static_assert(Index::positional, "List::at needs a positional Index policy");
+        if(pos >= _size)
+        {
+            throw std::out_of_range("List::at");
+        }
+        return static_cast<Node*>(node_at(pos))->data;
+    }
+
+    // The iterator at position pos. Positions at or past size() give end()
+    iterator iterator_at( size_type pos ) noexcept {
+        static_assert(Index::positional, "List::iterator_at needs a positional Index policy");
+        return iterator(node_at(pos));
+    }
+    const_iterator iterator_at( size_type pos ) const noexcept {
+        static_assert(Index::positional, "List::iterator_at needs a positional Index policy");
+        return const_iterator(node_at(pos));
+    }
+
+    // The position of pos; end() gives size()
+    size_type index_of( const_iterator pos ) const noexcept {
+        static_assert(Index::positional, "List::index_of needs a positional Index policy");
+        if(pos.node == &tail)
+        {
+            return _size;
+        }
+        index_tree().refresh(head.next, &tail);
+        return index_tree().rank(pos.node);
+    }
+
     void clear() noexcept {
-        Node *prevNode, *currentNode = head.next;
-        
+        NodeBase *prevNode, *currentNode = head.next;
+
         //Delete linked list contents
         while(currentNode != &tail)
         {
             prevNode = currentNode;
             currentNode = currentNode->next;
-            delete prevNode;
+            destroy_node(static_cast<Node*>(prevNode));
         }
 
         //Set linked list to empty state
         head.next = &tail;
         tail.prev = &head;
         _size = 0;
+        index_tree().reset();
     }
 
     iterator insert( const_iterator pos, const T& value ) {
-        
-        Node* insertedNode = new Node(value, pos.node->prev, pos.node);
-        pos.node->prev->next = insertedNode;
-        pos.node->prev = insertedNode;
-        _size++;
-
-        return iterator(insertedNode);
+        return emplace(pos, value);
     }
     iterator insert( const_iterator pos, T&& value ) {
-        
-        Node* insertedNode = new Node(std::move(value), pos.node->prev, pos.node);
-        pos.node->prev->next = insertedNode;
-        pos.node->prev = insertedNode;
-        _size++;
+        return emplace(pos, std::move(value));
+    }
 
-        return iterator(insertedNode);
+    // Construct an element in place from args, without temporaries
+    template <typename... Args>
+    iterator emplace( const_iterator pos, Args&&... args ) {
+        return iterator(link_node(pos.node, std::forward<Args>(args)...));
+    }
+
+    iterator erase( const_iterator first, const_iterator last ) {
+        while(first != last)
+        {
+            first = erase(first);
+        }
+        return iterator(last.node);
     }
 
     iterator erase( const_iterator pos ) {
-       
+
         iterator temp(pos.node->next);
-        pos.node->prev->next = pos.node->next;
-        pos.node->next->prev = pos.node->prev;
+        index_tree().erased(pos.node);
+        NodeBase::unlink(pos.node);
         _size--;
-        delete pos.node;
+        destroy_node(static_cast<Node*>(pos.node));
 
         return temp;
     }
 
     void push_back( const T& value ) {
-
-        Node* insertedNode = new Node(value, tail.prev, &tail);
-        tail.prev->next = insertedNode;
-        tail.prev = insertedNode;
-        _size++;
-
+        emplace_back(value);
     }
     void push_back( T&& value ) {
+        emplace_back(std::move(value));
+    }
 
-        Node* insertedNode = new Node(std::move(value), tail.prev, &tail);
-        tail.prev->next = insertedNode;
-        tail.prev = insertedNode;
-        _size++;
-
+    template <typename... Args>
+    reference emplace_back( Args&&... args ) {
+        return link_node(&tail, std::forward<Args>(args)...)->data;
     }
 
     void pop_back() {
-        
-        Node* deletedNode = tail.prev;
+
+        Node* deletedNode = static_cast<Node*>(tail.prev);
+        index_tree().erased(deletedNode);
         deletedNode->prev->next = &tail;
         tail.prev = deletedNode->prev;
         _size--;
-        delete deletedNode;
+        destroy_node(deletedNode);
 
     }
-	
-    void push_front( const T& value ) {
-        
-        Node* insertedNode = new Node(value, &head, head.next);
-        head.next->prev = insertedNode;
-        head.next = insertedNode;
-        _size++;
 
+    void push_front( const T& value ) {
+        emplace_front(value);
     }
 	void push_front( T&& value ) {
-        
-        Node* insertedNode = new Node(std::move(value), &head, head.next);
-        head.next->prev = insertedNode;
-        head.next = insertedNode;
-        _size++;
+        emplace_front(std::move(value));
+    }
 
+    template <typename... Args>
+    reference emplace_front( Args&&... args ) {
+        return link_node(head.next, std::forward<Args>(args)...)->data;
     }
 
     void pop_front() {
 
-        Node* deletedNode = head.next;
+        Node* deletedNode = static_cast<Node*>(head.next);
+        index_tree().erased(deletedNode);
         deletedNode->next->prev = &head;
         head.next = deletedNode->next;
         _size--;
-        delete deletedNode;
+        destroy_node(deletedNode);
 
     }
 
+    /*
+      Batched counterparts of push_back and pop_front. append_range
+      reuses cached nodes first, carves the rest of a measurable range
+      from as few slabs as possible and links the whole batch in one
+      step; pop_front_n moves its batch out, unlinks it from the front in
+      one step and then destroys it in a single pass. Slab nodes are
+      only freed once their whole slab is released.
+    */
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void append_range( InputIt first, InputIt last ) {
+        append_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+
+    // Move up to count elements from the front to out. Returns the number moved
+    template <typename OutputIt>
+    size_type pop_front_n( OutputIt out, size_type count ) {
+        if(count > _size)
+        {
+            count = _size;
+        }
+
+        NodeBase* currentNode = head.next;
+        size_type popped = 0;
+        try {
+            for(; popped < count; popped++, ++out)
+            {
+                *out = std::move(static_cast<Node*>(currentNode)->data);
+                currentNode = currentNode->next;
+            }
+        }
+        catch(...) {
+            // Drop what was already moved out before rethrowing
+            drop_front(currentNode, popped);
+            throw;
+        }
+
+        drop_front(currentNode, popped);
+        return popped;
+    }
+
+    /*
+      Splicing moves nodes between lists by relinking them, so no
+      elements are copied and no memory is allocated. Both lists must
+      use equal allocators.
+    */
+    // Move every element of other in front of pos in O(1)
+    void splice( const_iterator pos, List& other ) noexcept {
+        if(this == &other || other._size == 0)
+        {
+            return;
+        }
+
+        // An empty list can adopt other's index along with its nodes
+        if(_size == 0)
+        {
+            index_tree() = other.index_tree();
+        }
+        else
+        {
+            index_tree().invalidate();
+        }
+        other.index_tree().reset();
+
+        transfer(pos.node, other.head.next, &(other.tail));
+        _size += other._size;
+        other._size = 0;
+    }
+    void splice( const_iterator pos, List&& other ) noexcept {
+        splice(pos, other);
+    }
+
+    // Move the element at it from other in front of pos in O(1)
+    void splice( const_iterator pos, List& other, const_iterator it ) noexcept {
+        if(pos.node == it.node || pos.node == it.node->next)
+        {
+            return;
+        }
+
+        other.index_tree().erased(it.node);
+        transfer(pos.node, it.node, it.node->next);
+        _size++;
+        other._size--;
+        index_inserted(it.node);
+    }
+    void splice( const_iterator pos, List&& other, const_iterator it ) noexcept {
+        splice(pos, other, it);
+    }
+
+    // Move [first, last) from other in front of pos. Linear in the length
+    // of the range only when it has to be counted for another list
+    void splice( const_iterator pos, List& other, const_iterator first, const_iterator last ) noexcept {
+        if(first == last)
+        {
+            return;
+        }
+
+        if(this != &other)
+        {
+            size_type count = 0;
+            for(const_iterator currentSpot = first; currentSpot != last; currentSpot++)
+            {
+                count++;
+            }
+            _size += count;
+            other._size -= count;
+            other.index_tree().invalidate();
+        }
+
+        index_tree().invalidate();
+        transfer(pos.node, first.node, last.node);
+    }
+    void splice( const_iterator pos, List&& other, const_iterator first, const_iterator last ) noexcept {
+        splice(pos, other, first, last);
+    }
+
+    // Stable sort in O(n log n) by relinking nodes; elements are never
+    // copied, moved or reallocated
+    void sort() {
+        sort(std::less<T>());
+    }
+
+    template <typename Compare>
+    void sort( Compare comp ) {
+        if(_size < 2)
+        {
+            return;
+        }
+        index_tree().invalidate();
+
+        // Bottom-up merge sort over the next pointers only
+        NodeBase* sorted = head.next;
+        tail.prev->next = nullptr;
+
+        for(size_type width = 1; ; width *= 2)
+        {
+            NodeBase *left = sorted, *last = nullptr;
+            size_type merges = 0;
+            sorted = nullptr;
+
+            while(left != nullptr)
+            {
+                merges++;
+
+                // Split off a run of width nodes starting at left
+                NodeBase* right = left;
+                size_type leftSize = 0, rightSize = width;
+                while(leftSize < width && right != nullptr)
+                {
+                    leftSize++;
+                    right = right->next;
+                }
+
+                // Merge the two runs, taking from the left run on ties
+                while(leftSize > 0 || (rightSize > 0 && right != nullptr))
+                {
+                    NodeBase* next;
+                    if(leftSize == 0 || (rightSize > 0 && right != nullptr && comp(static_cast<Node*>(right)->data, static_cast<Node*>(left)->data)))
+                    {
+                        next = right;
+                        right = right->next;
+                        rightSize--;
+                    }
+                    else
+                    {
+                        next = left;
+                        left = left->next;
+                        leftSize--;
+                    }
+
+                    if(last != nullptr)
+                    {
+                        last->next = next;
+                    }
+                    else
+                    {
+                        sorted = next;
+                    }
+                    last = next;
+                }
+
+                left = right;
+            }
+            last->next = nullptr;
+
+            if(merges <= 1)
+            {
+                break;
+            }
+        }
+
+        // Restore the prev pointers and sentinel links
+        NodeBase* prevNode = &head;
+        for(NodeBase* currentNode = sorted; currentNode != nullptr; currentNode = currentNode->next)
+        {
+            prevNode->next = currentNode;
+            currentNode->prev = prevNode;
+            prevNode = currentNode;
+        }
+        prevNode->next = &tail;
+        tail.prev = prevNode;
+    }
+
+    // Keep up to limit freed nodes for reuse instead of returning them to
+    // the allocator. The default limit of zero disables recycling
+    void set_node_cache_limit( size_type limit ) noexcept {
+        _cache_limit = limit;
+        trim_cache(limit);
+    }
+    size_type node_cache_limit() const noexcept {
+        return _cache_limit;
+    }
+    size_type cached_nodes() const noexcept {
+        return _free_count;
+    }
+
+    // Return every cached node to the allocator
+    void shrink_to_fit() noexcept {
+        trim_cache(0);
+    }
+
+    // Exchange contents in O(1). Allocators are swapped only if they propagate
+    void swap( List& other ) noexcept {
+        if(this == &other)
+        {
+            return;
+        }
+
+        if(node_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        std::swap(_free_nodes, other._free_nodes);
+        std::swap(_free_count, other._free_count);
+        std::swap(_cache_limit, other._cache_limit);
+
+        NodeBase *first = head.next, *last = tail.prev;
+        size_type count = _size;
+        IndexTree index = index_tree();
+
+        steal_nodes(other);
+        if(count > 0)
+        {
+            other.head.next = first;
+            other.tail.prev = last;
+            first->prev = &(other.head);
+            last->next = &(other.tail);
+        }
+        other._size = count;
+        other.index_tree() = index;
+    }
+
     /*
       You do not need to modify these methods!
-      
-      These method provide the non-const complement 
+
+      These method provide the non-const complement
       for the const_iterator methods provided above.
     */
-    iterator insert( iterator pos, const T & value) { 
-        return insert((const_iterator &) (pos), value);
+    iterator insert( iterator pos, const T & value) {
+        return insert(const_iterator(pos), value);
     }
 
     iterator insert( iterator pos, T && value ) {
-        return insert((const_iterator &) (pos), std::move(value));
+        return insert(const_iterator(pos), std::move(value));
     }
 
     iterator erase( iterator pos ) {
-        return erase((const_iterator&)(pos));
+        return erase(const_iterator(pos));
     }
 };
 
-
-/*
-    You do not need to modify these methods!
-
-    These method provide a overload to compare const and 
-    non-const iterators safely.
-*/
- 
-namespace {
-    template<typename Iter, typename ConstIter, typename T>
-    using enable_for_list_iters = typename std::enable_if<
-        std::is_same<
-            typename List<typename std::iterator_traits<Iter>::value_type>::iterator, 
-            Iter
-        >{} && std::is_same<
-            typename List<typename std::iterator_traits<Iter>::value_type>::const_iterator,
-            ConstIter
-        >{}, T>::type;
-}
-
-template<typename Iterator, typename ConstIter>
-enable_for_list_iters<Iterator, ConstIter, bool> operator==(const Iterator & lhs, const ConstIter & rhs) {
-    return (const ConstIter &)(lhs) == rhs;
+template <class T, class Allocator, class Layout, class Index>
+void swap(List<T, Allocator, Layout, Index>& lhs, List<T, Allocator, Layout, Index>& rhs) noexcept {
+    lhs.swap(rhs);
 }
-
-template<typename Iterator, typename ConstIter>
-enable_for_list_iters<Iterator, ConstIter, bool> operator==(const ConstIter & lhs, const Iterator & rhs) {
-    return (const ConstIter &)(rhs) == lhs;
-}
-
-template<typename Iterator, typename ConstIter>
-enable_for_list_iters<Iterator, ConstIter, bool> operator!=(const Iterator & lhs, const ConstIter & rhs) {
-    return (const ConstIter &)(lhs) != rhs;
-}
-
-template<typename Iterator, typename ConstIter>
-enable_for_list_iters<Iterator, ConstIter, bool> operator!=(const ConstIter & lhs, const Iterator & rhs) {
-    return (const ConstIter &)(rhs) != lhs;
-}
\ No newline at end of file
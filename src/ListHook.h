@@ -0,0 +1,62 @@
+#pragma once
+
+/*
+    The next/prev links shared by List nodes and IntrusiveList elements,
+    together with the pointer surgery both containers perform on them.
+    None of these functions allocate, and all of them are O(1).
+
+    A copied hook starts out unlinked: links record where an object sits
+    in a list, which is not part of its value.
+*/
+struct ListHook {
+    ListHook *next, *prev;
+
+    explicit ListHook(ListHook* prev = nullptr, ListHook* next = nullptr) noexcept
+    : next{next}, prev{prev} {}
+    ListHook(const ListHook&) noexcept : next{nullptr}, prev{nullptr} {}
+    ListHook& operator=(const ListHook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return next != nullptr; }
+
+    // Link node in front of pos
+    static void link_before(ListHook* pos, ListHook* node) noexcept {
+        node->prev = pos->prev;
+        node->next = pos;
+        pos->prev->next = node;
+        pos->prev = node;
+    }
+
+    // Detach node from its neighbours. node keeps its stale links
+    static void unlink(ListHook* node) noexcept {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+    }
+
+    // Relink the nodes in [first, last) in front of pos
+    static void transfer(ListHook* pos, ListHook* first, ListHook* last) noexcept {
+        if(first == last || pos == last)
+        {
+            return;
+        }
+
+        ListHook* lastNode = last->prev;
+
+        // Unlink the range from its current neighbours
+        first->prev->next = last;
+        last->prev = first->prev;
+
+        // Link it in front of pos
+        first->prev = pos->prev;
+        lastNode->next = pos;
+        pos->prev->next = first;
+        pos->prev = lastNode;
+    }
+
+    // Point a pair of sentinels at each other
+    static void reset(ListHook& head, ListHook& tail) noexcept {
+        head.next = &tail;
+        head.prev = &tail;
+        tail.next = &head;
+        tail.prev = &head;
+    }
+};
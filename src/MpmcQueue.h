@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic> // std::atomic
+#include <cstddef> // size_t, ptrdiff_t
+#include <memory> // std::allocator, std::allocator_traits
+#include <new> // placement new, std::launder
+#include <thread> // std::this_thread::yield
+#include <utility> // std::move, std::forward
+
+/*
+    A bounded multi-producer/multi-consumer FIFO after Vyukov. The
+    ring is allocated once, with a capacity rounded up to a power of
+    two, so pushing and popping never allocate.
+
+    Every cell carries a sequence number which tells a thread whose
+    turn it is: a producer at position p may fill the cell once its
+    sequence equals p, and a consumer may empty it once it equals
+    p + 1. Threads claim positions with a CAS on the shared enqueue
+    or dequeue counter and then only touch their own cell.
+
+    try_push fails instead of waiting when the ring is full, which
+    makes the queue suitable for admission control. size and empty
+    are snapshots and may be stale as soon as they return.
+
+    Example:
+    {
+        MpmcQueue<int> q(1024);
+
+        if(!q.try_push(1))
+            reject();
+
+        int value;
+        if(q.try_pop(value))
+            std::cout << value << std::endl; // 1
+    }
+*/
+template <class T, class Allocator = std::allocator<T>>
+class MpmcQueue {
+    public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    private:
+    struct Cell {
+        std::atomic<size_type> sequence;
+        bool filled; // false if T's constructor threw
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* data() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    using cell_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Cell>;
+    using cell_traits         = std::allocator_traits<cell_allocator_type>;
+
+    // Producers and consumers each contend on their own cache line
+    alignas(64) std::atomic<size_type> _enqueue;
+    alignas(64) std::atomic<size_type> _dequeue;
+
+    // Fixed at construction
+    alignas(64) Cell* _cells;
+    size_type _mask;
+    cell_allocator_type _alloc;
+
+    static size_type round_up(size_type capacity) noexcept {
+        size_type rounded = 2;
+        while(rounded < capacity)
+        {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    // Claim the next cell to fill, or return nullptr if the ring is full
+    Cell* claim_enqueue(size_type& pos) noexcept {
+        pos = _enqueue.load(std::memory_order_relaxed);
+        while(true)
+        {
+            Cell* cell = &_cells[pos & _mask];
+            size_type sequence = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t lag = static_cast<ptrdiff_t>(sequence - pos);
+
+            if(lag == 0)
+            {
+                if(_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    return cell;
+                }
+            }
+            else if(lag < 0)
+            {
+                // The cell still holds the element from a lap ago
+                return nullptr;
+            }
+            else
+            {
+                pos = _enqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claim the next cell to empty, or return nullptr if the ring is empty
+    Cell* claim_dequeue(size_type& pos) noexcept {
+        pos = _dequeue.load(std::memory_order_relaxed);
+        while(true)
+        {
+            Cell* cell = &_cells[pos & _mask];
+            size_type sequence = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t lag = static_cast<ptrdiff_t>(sequence - (pos + 1));
+
+            if(lag == 0)
+            {
+                if(_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    return cell;
+                }
+            }
+            else if(lag < 0)
+            {
+                // No producer has filled this cell yet
+                return nullptr;
+            }
+            else
+            {
+                pos = _dequeue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    explicit MpmcQueue( size_type capacity, const Allocator& alloc = Allocator() )
+    : _enqueue{0}, _dequeue{0}, _cells{nullptr}, _mask{round_up(capacity) - 1}, _alloc(alloc) {
+        _cells = cell_traits::allocate(_alloc, _mask + 1);
+        for(size_type index = 0; index <= _mask; index++)
+        {
+            ::new(static_cast<void*>(_cells + index)) Cell;
+            _cells[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    // Threads share the queue by address
+    MpmcQueue( const MpmcQueue& other ) = delete;
+    MpmcQueue& operator=( const MpmcQueue& other ) = delete;
+
+    // Must not race with any other operation
+    ~MpmcQueue() {
+        size_type end = _enqueue.load();
+        for(size_type pos = _dequeue.load(); pos != end; pos++)
+        {
+            if(_cells[pos & _mask].filled)
+            {
+                _cells[pos & _mask].data()->~T();
+            }
+        }
+        cell_traits::deallocate(_alloc, _cells, _mask + 1);
+    }
+
+    size_type capacity() const noexcept {
+        return _mask + 1;
+    }
+
+    // Number of claimed positions not yet consumed; a snapshot
+    size_type size() const noexcept {
+        size_type dequeue = _dequeue.load(std::memory_order_acquire);
+        size_type enqueue = _enqueue.load(std::memory_order_acquire);
+        ptrdiff_t count = static_cast<ptrdiff_t>(enqueue - dequeue);
+        if(count < 0)
+        {
+            return 0;
+        }
+        return static_cast<size_type>(count) > capacity() ? capacity() : static_cast<size_type>(count);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Construct an element in place. Returns false, constructing nothing, if full
+    template <typename... Args>
+    bool try_emplace( Args&&... args ) {
+        size_type pos;
+        Cell* cell = claim_enqueue(pos);
+        if(cell == nullptr)
+        {
+            return false;
+        }
+
+        try
+        {
+            ::new(static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            // The position is already claimed and cannot be handed back,
+            // so publish it empty for a consumer to skip
+            cell->filled = false;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            throw;
+        }
+
+        cell->filled = true;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push( const T& value ) {
+        return try_emplace(value);
+    }
+    bool try_push( T&& value ) {
+        return try_emplace(std::move(value));
+    }
+
+    // Spin until there is room
+    template <typename... Args>
+    void emplace( Args&&... args ) {
+        while(!try_emplace(std::forward<Args>(args)...))
+        {
+            std::this_thread::yield();
+        }
+    }
+    void push( const T& value ) {
+        emplace(value);
+    }
+    void push( T&& value ) {
+        emplace(std::move(value));
+    }
+
+    // Move the oldest element into value. Returns false if the queue was empty
+    bool try_pop( T& value ) {
+        size_type pos;
+        Cell* cell = claim_dequeue(pos);
+        while(cell != nullptr && !cell->filled)
+        {
+            cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+            cell = claim_dequeue(pos);
+        }
+        if(cell == nullptr)
+        {
+            return false;
+        }
+
+        T* data = cell->data();
+        try
+        {
+            value = std::move(*data);
+        }
+        catch(...)
+        {
+            // The position is already claimed and cannot be handed back, so
+            // the element is dropped and the cell still released to producers
+            data->~T();
+            cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+            throw;
+        }
+        data->~T();
+
+        // Hand the cell to the producer one lap ahead
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+};
@@ -0,0 +1,456 @@
+#pragma once
+
+#include <atomic> // std::atomic
+#include <cstddef> // size_t
+#include <mutex> // std::mutex, std::lock_guard
+#include <new> // operator new, operator delete, std::align_val_t
+#include <type_traits> // std::true_type
+#include <utility> // std::swap
+
+/*
+    A process-wide pool of fixed-size blocks, shared by every thread,
+    after Bonwick's magazine allocator. Each thread keeps two
+    magazines of free blocks and allocates and frees against them
+    without locking. When a thread's magazines are both full it hands
+    one, as a single batch, to the global depot; when both are empty
+    it takes a full one from it.
+
+    Blocks go back to the thread that allocated them. Each block is
+    preceded by a header naming its owner, and a thread freeing
+    another thread's blocks collects them in an outgoing magazine,
+    which it pushes onto the owner's lock-free return list once full.
+    An owner that runs dry drains its return list before it turns to
+    the depot, so a producer gets back what its consumers free a
+    magazine at a time, and producers never compete for each other's
+    blocks. A thread that frees blocks of several owners in turn
+    sends each a partial magazine when the owner changes.
+
+    A thread's magazines and return list go to the depot when the
+    thread exits, and so do magazines sent to a thread that has
+    exited. Its owner record is kept and reused by a later thread.
+    Blocks are linked through their own storage while free, so the
+    magazines, return lists and depot need no memory of their own. The
+    depot keeps at most depot_limit magazines and frees what it cannot
+    keep. Alignments beyond what plain operator new guarantees, such
+    as cache_line_layout's 64 bytes, use the aligned operator new.
+
+    Example:
+    {
+        using Pool = NodePool<32, alignof(std::max_align_t)>;
+
+        void* block = Pool::instance().allocate();
+        Pool::instance().deallocate(block);
+    }
+*/
+template <size_t Size, size_t Align>
+class NodePool {
+    struct FreeBlock {
+        FreeBlock* next;        // next block in the same magazine
+        FreeBlock* next_batch;  // next magazine in a stack of them; on the first block only
+        size_t count;           // blocks in the magazine; on the first block only
+    };
+
+    // A thread that allocates from the pool. Records live as long as the
+    // pool, so a block's header may name one whose thread has exited
+    struct Owner {
+        std::atomic<FreeBlock*> returned{nullptr}; // magazines sent back by other threads
+        std::atomic<bool> active{true};
+        Owner* next = nullptr;
+    };
+
+    // Ahead of every block, padded so the block keeps its alignment
+    struct Header {
+        Owner* owner;
+    };
+
+public:
+    static constexpr size_t block_size = Size < sizeof(FreeBlock) ? sizeof(FreeBlock) : Size;
+    static constexpr size_t header_size = Align < sizeof(Header) ? sizeof(Header) : Align;
+    static constexpr size_t magazine_size = 64;
+    static constexpr size_t depot_limit = 1024;
+
+private:
+    struct Magazine {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+
+        void push(void* block) noexcept {
+            FreeBlock* freed = static_cast<FreeBlock*>(block);
+            freed->next = head;
+            head = freed;
+            count++;
+        }
+        void* pop() noexcept {
+            FreeBlock* block = head;
+            head = block->next;
+            count--;
+            return block;
+        }
+    };
+
+    // One per thread and pool; flushed to the depot when the thread exits
+    struct ThreadCache {
+        Magazine loaded, previous;
+        Owner* owner = nullptr;        // acquired on the first allocation
+        FreeBlock* returned = nullptr; // drained from owner, not yet loaded
+        Magazine outgoing;             // other threads' blocks, for outgoing_owner
+        Owner* outgoing_owner = nullptr;
+
+        ~ThreadCache() {
+            NodePool& pool = instance();
+            pool.send(outgoing, outgoing_owner);
+            pool.give(loaded);
+            pool.give(previous);
+            if(owner != nullptr)
+            {
+                pool.retire(*this);
+            }
+        }
+    };
+
+    std::mutex _lock;
+    FreeBlock* _depot = nullptr;
+    size_t _depot_count = 0;
+    Owner* _owners = nullptr;
+    std::atomic<size_t> _fresh_blocks{0};
+
+    static ThreadCache& cache() noexcept {
+        static thread_local ThreadCache local;
+        return local;
+    }
+
+    static Header* header_of(void* block) noexcept {
+        return reinterpret_cast<Header*>(static_cast<char*>(block) - header_size);
+    }
+
+    static void release(Magazine& magazine) noexcept {
+        while(magazine.count > 0)
+        {
+            deallocate_storage(header_of(magazine.pop()));
+        }
+    }
+
+    // Free every magazine in a stack linked through next_batch
+    static void release_all(FreeBlock* stack) noexcept {
+        while(stack != nullptr)
+        {
+            Magazine magazine{stack, stack->count};
+            stack = stack->next_batch;
+            release(magazine);
+        }
+    }
+
+    // Reuse the record of an exited thread, or add a new one
+    Owner* acquire() {
+        std::lock_guard<std::mutex> held(_lock);
+        for(Owner* owner = _owners; owner != nullptr; owner = owner->next)
+        {
+            if(!owner->active.load(std::memory_order_relaxed))
+            {
+                owner->active.store(true, std::memory_order_relaxed);
+                return owner;
+            }
+        }
+
+        Owner* owner = new Owner;
+        owner->next = _owners;
+        _owners = owner;
+        return owner;
+    }
+
+    // Give up an exiting thread's record, handing what was sent back to
+    // it to the depot. Magazines sent after this wait for the next thread
+    // to take the record, or for trim
+    void retire(ThreadCache& local) noexcept {
+        local.owner->active.store(false, std::memory_order_release);
+
+        give_all(local.returned);
+        local.returned = nullptr;
+        give_all(local.owner->returned.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    // Hand a magazine to the depot, or free its blocks if the depot is full
+    void give(Magazine& magazine) noexcept {
+        if(magazine.count == 0)
+        {
+            return;
+        }
+
+        magazine.head->count = magazine.count;
+        {
+            std::lock_guard<std::mutex> held(_lock);
+            if(_depot_count < depot_limit)
+            {
+                magazine.head->next_batch = _depot;
+                _depot = magazine.head;
+                _depot_count++;
+                magazine = Magazine{};
+                return;
+            }
+        }
+        release(magazine);
+    }
+
+    void give_all(FreeBlock* stack) noexcept {
+        while(stack != nullptr)
+        {
+            Magazine magazine{stack, stack->count};
+            stack = stack->next_batch;
+            give(magazine);
+        }
+    }
+
+    // Push a magazine onto owner's return list, or give it to the depot
+    // if owner's thread has exited
+    void send(Magazine& magazine, Owner* owner) noexcept {
+        if(magazine.count == 0)
+        {
+            return;
+        }
+        if(!owner->active.load(std::memory_order_acquire))
+        {
+            give(magazine);
+            return;
+        }
+
+        magazine.head->count = magazine.count;
+        FreeBlock* head = owner->returned.load(std::memory_order_relaxed);
+        do
+        {
+            magazine.head->next_batch = head;
+        } while(!owner->returned.compare_exchange_weak(head, magazine.head, std::memory_order_release, std::memory_order_relaxed));
+        magazine = Magazine{};
+    }
+
+    // Refill an empty magazine with blocks other threads sent back.
+    // Returns false if none have been
+    bool collect(ThreadCache& local) noexcept {
+        if(local.returned == nullptr)
+        {
+            if(local.owner->returned.load(std::memory_order_relaxed) == nullptr)
+            {
+                return false;
+            }
+            local.returned = local.owner->returned.exchange(nullptr, std::memory_order_acquire);
+        }
+
+        local.loaded.head = local.returned;
+        local.loaded.count = local.returned->count;
+        local.returned = local.returned->next_batch;
+        return true;
+    }
+
+    // Refill an empty magazine from the depot. Returns false if the depot is empty
+    bool take(Magazine& magazine) noexcept {
+        std::lock_guard<std::mutex> held(_lock);
+        if(_depot == nullptr)
+        {
+            return false;
+        }
+
+        magazine.head = _depot;
+        magazine.count = _depot->count;
+        _depot = _depot->next_batch;
+        _depot_count--;
+        return true;
+    }
+
+    NodePool() = default;
+
+public:
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        trim();
+        while(_owners != nullptr)
+        {
+            Owner* owner = _owners;
+            _owners = owner->next;
+            release_all(owner->returned.load());
+            delete owner;
+        }
+    }
+
+    static NodePool& instance() noexcept {
+        static NodePool pool;
+        return pool;
+    }
+
+    // Raw storage aligned to Align, through the aligned operator new when
+    // plain operator new does not guarantee that much
+    static void* allocate_storage(size_t bytes) {
+        if(Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            return ::operator new(bytes, std::align_val_t{Align});
+        }
+        return ::operator new(bytes);
+    }
+    static void deallocate_storage(void* ptr) noexcept {
+        if(Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            ::operator delete(ptr, std::align_val_t{Align});
+        }
+        else
+        {
+            ::operator delete(ptr);
+        }
+    }
+
+    void* allocate() {
+        ThreadCache& local = cache();
+        if(local.owner == nullptr)
+        {
+            local.owner = acquire();
+        }
+
+        void* block;
+        if(local.loaded.count == 0 && local.previous.count > 0)
+        {
+            std::swap(local.loaded, local.previous);
+        }
+        if(local.loaded.count > 0 || collect(local) || take(local.loaded))
+        {
+            block = local.loaded.pop();
+        }
+        else
+        {
+            char* storage = static_cast<char*>(allocate_storage(header_size + block_size));
+            ::new(static_cast<void*>(storage)) Header{nullptr};
+            _fresh_blocks.fetch_add(1, std::memory_order_relaxed);
+            block = storage + header_size;
+        }
+
+        header_of(block)->owner = local.owner;
+        return block;
+    }
+
+    void deallocate(void* block) noexcept {
+        ThreadCache& local = cache();
+        Owner* owner = header_of(block)->owner;
+        if(owner != local.owner)
+        {
+            // Batch another thread's blocks up to send back to it
+            if(owner != local.outgoing_owner)
+            {
+                send(local.outgoing, local.outgoing_owner);
+                local.outgoing_owner = owner;
+            }
+            local.outgoing.push(block);
+            if(local.outgoing.count == magazine_size)
+            {
+                send(local.outgoing, owner);
+            }
+            return;
+        }
+
+        if(local.loaded.count == magazine_size)
+        {
+            if(local.previous.count == 0)
+            {
+                std::swap(local.loaded, local.previous);
+            }
+            else
+            {
+                give(local.previous);
+                local.previous = local.loaded;
+                local.loaded = Magazine{};
+            }
+        }
+        local.loaded.push(block);
+    }
+
+    // Free every block held by the depot, and any sent back to exited
+    // threads. Blocks in running threads' magazines and return lists stay
+    void trim() noexcept {
+        FreeBlock* depot;
+        FreeBlock* orphaned = nullptr;
+        {
+            // Holding the lock keeps exited threads' records from being reused
+            std::lock_guard<std::mutex> held(_lock);
+            depot = _depot;
+            _depot = nullptr;
+            _depot_count = 0;
+
+            for(Owner* owner = _owners; owner != nullptr; owner = owner->next)
+            {
+                if(!owner->active.load(std::memory_order_relaxed))
+                {
+                    FreeBlock* stack = owner->returned.exchange(nullptr, std::memory_order_acquire);
+                    while(stack != nullptr)
+                    {
+                        FreeBlock* next = stack->next_batch;
+                        stack->next_batch = orphaned;
+                        orphaned = stack;
+                        stack = next;
+                    }
+                }
+            }
+        }
+
+        release_all(depot);
+        release_all(orphaned);
+    }
+
+    // Blocks requested from operator new so far
+    size_t fresh_blocks() const noexcept {
+        return _fresh_blocks.load(std::memory_order_relaxed);
+    }
+
+    // Magazines waiting in the depot
+    size_t depot_size() noexcept {
+        std::lock_guard<std::mutex> held(_lock);
+        return _depot_count;
+    }
+};
+
+/*
+    A stateless allocator that serves single-object allocations, such
+    as List nodes, from the NodePool for their size. Larger requests
+    (List's bulk slabs, for instance) go straight to operator new.
+
+    Example:
+    {
+        List<int, NodeCacheAllocator<int>> ll;
+        ll.push_back(1); // node from this thread's magazine
+    }
+*/
+template <class T>
+class NodeCacheAllocator {
+public:
+    using value_type      = T;
+    using is_always_equal = std::true_type;
+    using pool_type       = NodePool<sizeof(T), alignof(T)>;
+
+    NodeCacheAllocator() noexcept = default;
+    template <class U>
+    NodeCacheAllocator(const NodeCacheAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if(count == 1)
+        {
+            return static_cast<T*>(pool_type::instance().allocate());
+        }
+        return static_cast<T*>(pool_type::allocate_storage(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        if(count == 1)
+        {
+            pool_type::instance().deallocate(ptr);
+        }
+        else
+        {
+            pool_type::deallocate_storage(ptr);
+        }
+    }
+
+    template <class U>
+    bool operator==(const NodeCacheAllocator<U>&) const noexcept {
+        return true;
+    }
+    template <class U>
+    bool operator!=(const NodeCacheAllocator<U>&) const noexcept {
+        return false;
+    }
+};
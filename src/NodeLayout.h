@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint> // uint16_t
+#include <utility> // std::forward, std::in_place_t
+
+/*
+    Layout policies for List nodes, passed as List's third template
+    parameter. Each policy provides a node<Hook, Slab, T> template: a
+    node derives from Hook, which holds its next/prev links, exposes its
+    element as data, and finds the bulk slab it was carved from (nullptr
+    for a node allocated on its own) through slab().
+
+    No layout stores a slab pointer. Slab nodes sit at block[index] with
+    the slab header in block[0], so a node keeps only its index and
+    derives the header from its own address; index 0 marks a node that
+    is not part of a slab. A slab holds at most 16384 / sizeof(node)
+    nodes, so the index fits in 16 bits and fills padding the node would
+    carry anyway: List<int> nodes stay at 24 bytes on 64-bit targets,
+    and so do nodes of 6 byte, 2 byte aligned elements.
+
+    pointers_first_layout  links, the slab index, then the element. The
+                           default, and List's historical layout.
+    data_first_layout      the element and its slab index, then the
+                           links, so the element starts the node's first
+                           cache line.
+    cache_line_layout      pointers first, aligned and padded to a 64 byte
+                           cache line so threads working on neighbouring
+                           nodes never share a line.
+
+    Example:
+    {
+        List<int, std::allocator<int>, data_first_layout> ll;
+        ll.push_back(1);
+        std::cout << ll.node_size << std::endl; // 24 on 64-bit targets
+    }
+*/
+
+// Where a node sits in its slab; List checks its slabs never outgrow it
+using slab_index_type = uint16_t;
+
+// The index of node within the slab block starting at slab, or 0 without one
+template <class Index, class Node, class Slab>
+Index slab_index_of(const Node* node, const Slab* slab) noexcept {
+    return slab == nullptr ? 0 : static_cast<Index>(node - reinterpret_cast<const Node*>(slab));
+}
+
+// The slab header index nodes before node, or nullptr for index 0
+template <class Slab, class Node, class Index>
+Slab* slab_from_index(const Node* node, Index index) noexcept {
+    return index == 0 ? nullptr : reinterpret_cast<Slab*>(const_cast<Node*>(node) - index);
+}
+
+struct pointers_first_layout {
+    template <class Hook, class Slab, class T>
+    struct node : Hook {
+        slab_index_type index;
+        T data;
+
+        template <typename... Args>
+        explicit node(std::in_place_t, Slab* slab, Args&&... args)
+        : Hook{}, index{slab_index_of<slab_index_type>(this, slab)}, data(std::forward<Args>(args)...) {}
+
+        Slab* slab() const noexcept { return slab_from_index<Slab>(this, index); }
+    };
+};
+
+struct data_first_layout {
+    // Holds the element, and the slab index in its tail, ahead of the links
+    template <class T>
+    struct payload {
+        T data;
+        slab_index_type index;
+
+        template <typename... Args>
+        explicit payload(std::in_place_t, slab_index_type index, Args&&... args)
+        : data(std::forward<Args>(args)...), index{index} {}
+    };
+
+    template <class Hook, class Slab, class T>
+    struct node : payload<T>, Hook {
+        template <typename... Args>
+        explicit node(std::in_place_t, Slab* slab, Args&&... args)
+        : payload<T>(std::in_place, slab_index_of<slab_index_type>(this, slab), std::forward<Args>(args)...), Hook{} {}
+
+        Slab* slab() const noexcept { return slab_from_index<Slab>(this, this->index); }
+    };
+};
+
+struct cache_line_layout {
+    template <class Hook, class Slab, class T>
+    struct alignas(64) node : Hook {
+        slab_index_type index;
+        T data;
+
+        template <typename... Args>
+        explicit node(std::in_place_t, Slab* slab, Args&&... args)
+        : Hook{}, index{slab_index_of<slab_index_type>(this, slab)}, data(std::forward<Args>(args)...) {}
+
+        Slab* slab() const noexcept { return slab_from_index<Slab>(this, index); }
+    };
+};
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+
+#include "ListHook.h" // ListHook
+
+/*
+    Positional index policies for List, passed as its fourth template
+    parameter. A policy supplies hook<Base>, the link type List's nodes
+    derive from, and tree, the index object List holds as a private
+    base so an empty tree adds nothing to sizeof(List). List reports
+    single-node inserts and erases to the tree as they happen; bulk
+    relinking (sort, range splices, large appends) only marks the tree
+    stale, and the next positional query rebuilds it in O(n).
+
+    no_index               the default. Adds no storage to the nodes or
+                           the list, and its notifications compile to
+                           nothing; List's positional calls are
+                           unavailable.
+    order_statistic_index  an implicit treap threaded through the nodes,
+                           ordered by list position and balanced by a
+                           hash of each node's address. Adds a parent,
+                           two children and a subtree size to every node;
+                           inserts, erases, List::at, iterator_at and
+                           index_of take O(log n) expected time.
+
+    Example:
+    {
+        List<int, std::allocator<int>, pointers_first_layout, order_statistic_index> ll = {1, 2, 3};
+
+        ll.at(1); // 2
+        ll.index_of(ll.iterator_at(2)); // 2
+    }
+*/
+
+struct no_index {
+    static constexpr bool positional = false;
+
+    template <class Base>
+    using hook = Base;
+
+    struct tree {
+        void inserted(ListHook*, ListHook*, ListHook*) noexcept {}
+        void erased(ListHook*) noexcept {}
+        void invalidate() noexcept {}
+        void reset() noexcept {}
+    };
+};
+
+struct order_statistic_index {
+    static constexpr bool positional = true;
+
+    template <class Base>
+    struct hook : Base {
+        hook *parent, *left, *right;
+        size_t size; // nodes in the subtree rooted here
+
+        hook() : Base{}, parent{nullptr}, left{nullptr}, right{nullptr}, size{1} {}
+    };
+
+    class tree {
+        using Node = hook<ListHook>;
+
+        // Const queries on a stale tree rebuild it, so both may change under them
+        mutable Node* _root = nullptr;
+        mutable bool _stale = false;
+
+        static size_t size(const Node* node) noexcept {
+            return node == nullptr ? 0 : node->size;
+        }
+
+        static void resize(Node* node) noexcept {
+            node->size = 1 + size(node->left) + size(node->right);
+        }
+
+        // Heap priority: a mix of the node's address, so no state is kept
+        static uintptr_t priority(const Node* node) noexcept {
+            uintptr_t bits = reinterpret_cast<uintptr_t>(node);
+            bits ^= bits >> 31;
+            bits *= static_cast<uintptr_t>(0x9E3779B97F4A7C15ULL);
+            bits ^= bits >> 29;
+            return bits;
+        }
+
+        // Rotate node above its parent, keeping the in-order sequence
+        void rotate_up(Node* node) noexcept {
+            Node* parent = node->parent;
+            Node* grandparent = parent->parent;
+
+            if(node == parent->left)
+            {
+                parent->left = node->right;
+                if(node->right != nullptr)
+                {
+                    node->right->parent = parent;
+                }
+                node->right = parent;
+            }
+            else
+            {
+                parent->right = node->left;
+                if(node->left != nullptr)
+                {
+                    node->left->parent = parent;
+                }
+                node->left = parent;
+            }
+
+            parent->parent = node;
+            node->parent = grandparent;
+            if(grandparent == nullptr)
+            {
+                _root = node;
+            }
+            else if(grandparent->left == parent)
+            {
+                grandparent->left = node;
+            }
+            else
+            {
+                grandparent->right = node;
+            }
+
+            resize(parent);
+            resize(node);
+        }
+
+        // The first node of a post-order walk of the subtree at node
+        static Node* deepest_first(Node* node) noexcept {
+            while(node->left != nullptr || node->right != nullptr)
+            {
+                node = node->left != nullptr ? node->left : node->right;
+            }
+            return node;
+        }
+
+        // Build the treap over [first, last) in O(n): a Cartesian tree by
+        // priority whose in-order sequence is the list order
+        void rebuild(ListHook* first, const ListHook* last) const noexcept {
+            _root = nullptr;
+            _stale = false;
+
+            Node* previous = nullptr;
+            for(ListHook* link = first; link != last; link = link->next)
+            {
+                Node* node = static_cast<Node*>(link);
+                Node* above = previous;
+                Node* below = nullptr;
+                while(above != nullptr && priority(above) < priority(node))
+                {
+                    below = above;
+                    above = above->parent;
+                }
+
+                node->left = below;
+                node->right = nullptr;
+                if(below != nullptr)
+                {
+                    below->parent = node;
+                }
+
+                node->parent = above;
+                if(above == nullptr)
+                {
+                    _root = node;
+                }
+                else
+                {
+                    above->right = node;
+                }
+                previous = node;
+            }
+
+            // Subtree sizes, children before parents
+            if(_root == nullptr)
+            {
+                return;
+            }
+            Node* node = deepest_first(_root);
+            while(true)
+            {
+                resize(node);
+                Node* parent = node->parent;
+                if(parent == nullptr)
+                {
+                    break;
+                }
+                node = (node == parent->left && parent->right != nullptr) ? deepest_first(parent->right) : parent;
+            }
+        }
+
+    public:
+        // link was linked between the data nodes prev and next (nullptr at the ends)
+        void inserted(ListHook* link, ListHook* prev, ListHook* next) noexcept {
+            Node* node = static_cast<Node*>(link);
+            node->left = node->right = nullptr;
+            node->size = 1;
+            if(_stale)
+            {
+                return;
+            }
+
+            Node* before = static_cast<Node*>(prev);
+            if(_root == nullptr)
+            {
+                node->parent = nullptr;
+                _root = node;
+                return;
+            }
+            // In-order, node goes right after prev or right before next; one
+            // of those two slots is always free
+            if(before != nullptr && before->right == nullptr)
+            {
+                before->right = node;
+                node->parent = before;
+            }
+            else
+            {
+                Node* after = static_cast<Node*>(next);
+                after->left = node;
+                node->parent = after;
+            }
+
+            for(Node* above = node->parent; above != nullptr; above = above->parent)
+            {
+                above->size++;
+            }
+            while(node->parent != nullptr && priority(node->parent) < priority(node))
+            {
+                rotate_up(node);
+            }
+        }
+
+        // link is about to leave the list
+        void erased(ListHook* link) noexcept {
+            if(_stale)
+            {
+                return;
+            }
+
+            // Rotate the node down to a leaf, then cut it off
+            Node* node = static_cast<Node*>(link);
+            while(node->left != nullptr || node->right != nullptr)
+            {
+                Node* child = node->left;
+                if(child == nullptr || (node->right != nullptr && priority(node->right) > priority(child)))
+                {
+                    child = node->right;
+                }
+                rotate_up(child);
+            }
+
+            Node* parent = node->parent;
+            if(parent == nullptr)
+            {
+                _root = nullptr;
+                return;
+            }
+            (parent->left == node ? parent->left : parent->right) = nullptr;
+            for(; parent != nullptr; parent = parent->parent)
+            {
+                parent->size--;
+            }
+        }
+
+        // The list was relinked in bulk; rebuild before the next query
+        void invalidate() noexcept {
+            _root = nullptr;
+            _stale = true;
+        }
+
+        // The list is empty
+        void reset() noexcept {
+            _root = nullptr;
+            _stale = false;
+        }
+
+        // Bring the index up to date with the list [first, last)
+        void refresh(ListHook* first, const ListHook* last) const noexcept {
+            if(_stale)
+            {
+                rebuild(first, last);
+            }
+        }
+
+        // The node at position index. Requires index < size
+        ListHook* select(size_t index) const noexcept {
+            Node* node = _root;
+            while(true)
+            {
+                size_t left = size(node->left);
+                if(index < left)
+                {
+                    node = node->left;
+                }
+                else if(index == left)
+                {
+                    return node;
+                }
+                else
+                {
+                    index -= left + 1;
+                    node = node->right;
+                }
+            }
+        }
+
+        // The position of the data node link
+        size_t rank(const ListHook* link) const noexcept {
+            const Node* node = static_cast<const Node*>(link);
+            size_t position = size(node->left);
+            for(; node->parent != nullptr; node = node->parent)
+            {
+                if(node == node->parent->right)
+                {
+                    position += size(node->parent->left) + 1;
+                }
+            }
+            return position;
+        }
+    };
+};
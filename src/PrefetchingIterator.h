@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::forward_iterator_tag, std::iterator_traits
+#include <memory> // std::addressof
+
+// How many elements ahead traversal helpers prefetch unless told otherwise
+constexpr size_t default_prefetch_distance = 8;
+
+// Hint that the cache line at address will soon be read. A no-op where
+// the compiler offers no prefetch builtin
+inline void prefetch_read(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void) address;
+#endif
+}
+
+/*
+    A forward iterator adaptor that keeps a second, leading iterator
+    Distance elements ahead of the current one and prefetches each
+    element the lead reaches. The lead only steps past an element on
+    the increment after prefetching it, so in a node-based container
+    the miss on each node overlaps with the work done on the current
+    element instead of stalling the step that follows the prefetch.
+
+    The adaptor carries the end of its range so the lead never walks
+    past it; compare against an adaptor built from (last, last).
+    Distance is a compile-time constant; 0 disables prefetching.
+
+    Example:
+    {
+        List<int> ll = {1, 2, 3};
+
+        prefetching_iterator<List<int>::iterator> first(ll.begin(), ll.end());
+        prefetching_iterator<List<int>::iterator> last(ll.end(), ll.end());
+
+        int sum = 0;
+        for(; first != last; ++first)
+            sum += *first;
+    }
+*/
+template <class Iterator, size_t Distance = default_prefetch_distance>
+class prefetching_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = typename std::iterator_traits<Iterator>::value_type;
+    using difference_type   = typename std::iterator_traits<Iterator>::difference_type;
+    using pointer           = typename std::iterator_traits<Iterator>::pointer;
+    using reference         = typename std::iterator_traits<Iterator>::reference;
+
+    static constexpr size_t distance = Distance;
+
+private:
+    Iterator current, lead, last;
+
+    // Step the lead past the element it prefetched last time, then prefetch
+    // the one it lands on without reading it
+    void advance_lead() {
+        if(lead != last)
+        {
+            ++lead;
+            if(lead != last)
+            {
+                prefetch_read(std::addressof(*lead));
+            }
+        }
+    }
+
+public:
+    prefetching_iterator() = default;
+    prefetching_iterator(Iterator first, Iterator last) : current{first}, lead{first}, last{last} {
+        for(size_t i = 0; i < Distance; i++)
+        {
+            advance_lead();
+        }
+    }
+
+    // The adapted iterator
+    Iterator base() const {
+        return current;
+    }
+
+    reference operator*() const {
+        return *current;
+    }
+    pointer operator->() const {
+        return std::addressof(*current);
+    }
+
+    // Prefix Increment: ++a
+    prefetching_iterator& operator++() {
+        ++current;
+        if(Distance > 0)
+        {
+            advance_lead();
+        }
+        return *this;
+    }
+    // Postfix Increment: a++
+    prefetching_iterator operator++(int) {
+        prefetching_iterator temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    bool operator==(const prefetching_iterator& other) const {
+        return current == other.current;
+    }
+    bool operator!=(const prefetching_iterator& other) const {
+        return current != other.current;
+    }
+};
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <functional> // std::less
+#include <memory> // std::allocator, std::allocator_traits
+#include <utility> // std::move, std::forward, std::swap, std::in_place
+
+#include "ListHook.h" // ListHook
+
+/*
+    A priority queue over a pairing heap. top() is the element that
+    compares greatest under Compare, as with std::priority_queue, so
+    PriorityQueue<Job, std::greater<Job>> pops the earliest deadline
+    first.
+
+    push and merge are O(1); pop and erase are amortised O(log n).
+    Every push returns a handle that stays valid until its element is
+    popped or erased, even across merges, and decrease_key moves the
+    element towards the top in O(1) amortised.
+
+    Nodes link to their siblings through the same ListHook List uses:
+    next is the next sibling and prev is the previous sibling, or the
+    parent for a first child.
+
+    Example:
+    {
+        PriorityQueue<int, std::greater<int>> q;
+
+        q.push(5);
+        auto h = q.push(9);
+        q.decrease_key(h, 1);
+
+        std::cout << q.top() << std::endl; // 1
+    }
+*/
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+class PriorityQueue {
+    private:
+    struct Node : ListHook {
+        Node* child;
+        T data;
+        // Constructs data in place from args
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args)
+        : ListHook{}, child{nullptr}, data(std::forward<Args>(args)...) {}
+    };
+
+public:
+    using value_type      = T;
+    using value_compare   = Compare;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    // Refers to one element for decrease_key and erase. The element is
+    // read-only through a handle so it cannot be reordered behind the heap
+    class handle {
+        friend PriorityQueue;
+
+        Node* node;
+
+        explicit handle(Node* node) noexcept : node{node} {}
+
+    public:
+        handle() noexcept : node{nullptr} {}
+
+        const_reference operator*() const {
+            return node->data;
+        }
+        const T* operator->() const {
+            return &node->data;
+        }
+
+        bool operator==(const handle& other) const noexcept {
+            return node == other.node;
+        }
+        bool operator!=(const handle& other) const noexcept {
+            return node != other.node;
+        }
+    };
+
+private:
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits         = std::allocator_traits<node_allocator_type>;
+
+    Node* _root;
+    size_type _size;
+    Compare _comp;
+    node_allocator_type _alloc;
+
+    static Node* next_of(const Node* node) noexcept {
+        return static_cast<Node*>(node->next);
+    }
+    static Node* prev_of(const Node* node) noexcept {
+        return static_cast<Node*>(node->prev);
+    }
+
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = node_traits::allocate(_alloc, 1);
+        try {
+            node_traits::construct(_alloc, node, std::in_place, std::forward<Args>(args)...);
+        }
+        catch(...) {
+            node_traits::deallocate(_alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(Node* node) noexcept {
+        node_traits::destroy(_alloc, node);
+        node_traits::deallocate(_alloc, node, 1);
+    }
+
+    // Link two detached trees, making the lower priority root the first
+    // child of the other. Returns the new root
+    Node* meld(Node* first, Node* second) noexcept {
+        if(first == nullptr)
+        {
+            return second;
+        }
+        if(second == nullptr)
+        {
+            return first;
+        }
+        if(_comp(first->data, second->data))
+        {
+            std::swap(first, second);
+        }
+
+        second->next = first->child;
+        if(first->child != nullptr)
+        {
+            first->child->prev = second;
+        }
+        second->prev = first;
+        first->child = second;
+        return first;
+    }
+
+    // Cut the subtree rooted at node out of its parent's child list
+    static void detach(Node* node) noexcept {
+        Node* prev = prev_of(node);
+        if(prev->child == node)
+        {
+            prev->child = next_of(node);
+        }
+        else
+        {
+            prev->next = node->next;
+        }
+        if(node->next != nullptr)
+        {
+            node->next->prev = prev;
+        }
+        node->next = node->prev = nullptr;
+    }
+
+    // Two-pass pairing: meld siblings in pairs left to right, then meld
+    // the pairs right to left. Returns the root of the combined tree
+    Node* combine_siblings(Node* first) noexcept {
+        // The melded pairs are chained through next in reverse order
+        Node* pairs = nullptr;
+        while(first != nullptr)
+        {
+            Node* second = next_of(first);
+            Node* rest = second == nullptr ? nullptr : next_of(second);
+
+            first->next = first->prev = nullptr;
+            if(second != nullptr)
+            {
+                second->next = second->prev = nullptr;
+            }
+
+            Node* pair = meld(first, second);
+            pair->next = pairs;
+            pairs = pair;
+            first = rest;
+        }
+
+        Node* root = nullptr;
+        while(pairs != nullptr)
+        {
+            Node* pair = pairs;
+            pairs = next_of(pairs);
+            pair->next = nullptr;
+            root = meld(root, pair);
+        }
+        return root;
+    }
+
+    // Take node out of the heap, keeping its descendants in it
+    void unlink(Node* node) noexcept {
+        if(node == _root)
+        {
+            _root = nullptr;
+        }
+        else
+        {
+            detach(node);
+        }
+
+        Node* children = node->child;
+        node->child = nullptr;
+        if(children != nullptr)
+        {
+            children->prev = nullptr;
+        }
+        _root = meld(_root, combine_siblings(children));
+    }
+
+    // Restore heap order after node's priority rose
+    void raise(Node* node) noexcept {
+        if(node != _root)
+        {
+            detach(node);
+            _root = meld(_root, node);
+        }
+    }
+
+    // Visit every node, parents before children, without recursion
+    template <typename Fn>
+    static void for_each_node(Node* root, Fn fn) {
+        Node* node = root;
+        while(node != nullptr)
+        {
+            fn(node);
+            if(node->child != nullptr)
+            {
+                node = node->child;
+                continue;
+            }
+
+            // Climb until some ancestor has an unvisited sibling
+            while(node != root && node->next == nullptr)
+            {
+                while(prev_of(node)->child != node)
+                {
+                    node = prev_of(node);
+                }
+                node = prev_of(node);
+            }
+            node = node == root ? nullptr : next_of(node);
+        }
+    }
+
+public:
+    PriorityQueue(): PriorityQueue(Compare(), Allocator()) {}
+    explicit PriorityQueue( const Compare& comp, const Allocator& alloc = Allocator() )
+    : _root(nullptr), _size(0), _comp(comp), _alloc(alloc) {}
+    explicit PriorityQueue( const Allocator& alloc ): PriorityQueue(Compare(), alloc) {}
+    PriorityQueue( const PriorityQueue& other )
+    : PriorityQueue(other._comp, node_traits::select_on_container_copy_construction(other._alloc)) {
+        for_each_node(other._root, [this](Node* node) { push(node->data); });
+    }
+    PriorityQueue( PriorityQueue&& other ) noexcept
+    : _root(other._root), _size(other._size), _comp(other._comp), _alloc(std::move(other._alloc)) {
+        other._root = nullptr;
+        other._size = 0;
+    }
+    ~PriorityQueue() {
+        clear();
+    }
+    // Handles into this queue are invalidated by assignment
+    PriorityQueue& operator=( const PriorityQueue& other ) {
+        if(this != &other)
+        {
+            clear();
+            _comp = other._comp;
+            if(node_traits::propagate_on_container_copy_assignment::value)
+            {
+                _alloc = other._alloc;
+            }
+            for_each_node(other._root, [this](Node* node) { push(node->data); });
+        }
+        return *this;
+    }
+    PriorityQueue& operator=( PriorityQueue&& other ) noexcept(
+        node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value) {
+        if(this != &other)
+        {
+            clear();
+            _comp = other._comp;
+            if(node_traits::propagate_on_container_move_assignment::value)
+            {
+                _alloc = std::move(other._alloc);
+            }
+
+            if(node_traits::propagate_on_container_move_assignment::value || _alloc == other._alloc)
+            {
+                std::swap(_root, other._root);
+                std::swap(_size, other._size);
+            }
+            else
+            {
+                for_each_node(other._root, [this](Node* node) { push(std::move(node->data)); });
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(_alloc);
+    }
+
+    value_compare value_comp() const {
+        return _comp;
+    }
+
+    // The element with the highest priority. The queue must not be empty
+    const_reference top() const {
+        return _root->data;
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    void clear() noexcept {
+        // Free the tree by splicing each node's children into the
+        // work list ahead of its remaining siblings
+        Node* pending = _root;
+        while(pending != nullptr)
+        {
+            Node* node = pending;
+            pending = next_of(node);
+
+            Node* child = node->child;
+            if(child != nullptr)
+            {
+                Node* last = child;
+                while(last->next != nullptr)
+                {
+                    last = next_of(last);
+                }
+                last->next = pending;
+                pending = child;
+            }
+            destroy_node(node);
+        }
+
+        _root = nullptr;
+        _size = 0;
+    }
+
+    handle push( const T& value ) {
+        return emplace(value);
+    }
+    handle push( T&& value ) {
+        return emplace(std::move(value));
+    }
+    template <typename... Args>
+    handle emplace( Args&&... args ) {
+        Node* node = create_node(std::forward<Args>(args)...);
+        _root = meld(_root, node);
+        _size++;
+        return handle(node);
+    }
+
+    void pop() {
+        Node* node = _root;
+        unlink(node);
+        destroy_node(node);
+        _size--;
+    }
+
+    // Give the element at pos a value that compares no lower than its
+    // current one, moving it up the heap
+    void decrease_key( handle pos, const T& value ) {
+        pos.node->data = value;
+        raise(pos.node);
+    }
+    void decrease_key( handle pos, T&& value ) {
+        pos.node->data = std::move(value);
+        raise(pos.node);
+    }
+
+    // Give the element at pos any new value. Falls back to a remove and
+    // reinsert of the node, without reallocating, when its priority drops
+    void update( handle pos, const T& value ) {
+        if(!_comp(value, pos.node->data))
+        {
+            decrease_key(pos, value);
+            return;
+        }
+
+        unlink(pos.node);
+        try
+        {
+            pos.node->data = value;
+        }
+        catch(...)
+        {
+            // Put the node back so it is not lost from the heap
+            _root = meld(_root, pos.node);
+            throw;
+        }
+        _root = meld(_root, pos.node);
+    }
+
+    void erase( handle pos ) {
+        unlink(pos.node);
+        destroy_node(pos.node);
+        _size--;
+    }
+
+    // Move every element of other into this queue in O(1). Handles into
+    // other stay valid and now refer into this queue. The allocators
+    // must compare equal
+    void merge( PriorityQueue& other ) noexcept {
+        if(this == &other)
+        {
+            return;
+        }
+
+        _root = meld(_root, other._root);
+        _size += other._size;
+        other._root = nullptr;
+        other._size = 0;
+    }
+
+    // Exchange contents in O(1). Allocators are swapped only if they propagate
+    void swap( PriorityQueue& other ) noexcept {
+        using std::swap;
+        if(node_traits::propagate_on_container_swap::value)
+        {
+            swap(_alloc, other._alloc);
+        }
+        swap(_comp, other._comp);
+        swap(_root, other._root);
+        swap(_size, other._size);
+    }
+};
+
+template <class T, class Compare, class Allocator>
+void swap(PriorityQueue<T, Compare, Allocator>& lhs, PriorityQueue<T, Compare, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -1,5 +1,9 @@
 #ifndef QUEUE_H
 #define QUEUE_H
+#include <algorithm> // std::equal, std::lexicographical_compare
+#if __cplusplus >= 202002L
+#include <compare> // std::compare_three_way_result_t
+#endif
 #include "List.h"
 
 template <typename T, typename Container = List<T>>
@@ -7,6 +11,13 @@ class Queue {
 
     template <typename T1, typename C1>
     friend bool operator==(const Queue<T1, C1>&, const Queue<T1, C1>&);
+    template <typename T1, typename C1>
+    friend bool operator<(const Queue<T1, C1>&, const Queue<T1, C1>&);
+#if __cplusplus >= 202002L
+    template <typename T1, typename C1>
+        requires std::three_way_comparable<T1>
+    friend std::compare_three_way_result_t<T1> operator<=>(const Queue<T1, C1>&, const Queue<T1, C1>&);
+#endif
 
     public:
         // Aliases for accessing data types outside of the class
@@ -22,6 +33,8 @@ class Queue {
     public:
         // The constructors, destructor, and assignment operators are done for you
         Queue() = default;
+        explicit Queue(const Container& cont) : c(cont) {}
+        explicit Queue(Container&& cont) : c(std::move(cont)) {}
         Queue(const Queue& other) = default;
         Queue(Queue&& other) = default;
         ~Queue() = default;
@@ -38,28 +51,61 @@ class Queue {
 
         void push(const value_type& value) { c.push_back(value);}
         void push(value_type&& value) { c.push_back(std::move(value)); }
+        template <typename... Args>
+        decltype(auto) emplace(Args&&... args) { return c.emplace_back(std::forward<Args>(args)...); }
         void pop() { c.pop_front(); }
+
+        // Batched push and pop, so a whole batch shares one allocation,
+        // one relink and one size update where the container allows it
+        template <typename InputIt>
+        void push_range(InputIt first, InputIt last) { c.append_range(first, last); }
+        // Moves up to count elements to out, oldest first. Returns the number moved
+        template <typename OutputIt>
+        size_type pop_n(OutputIt out, size_type count) { return c.pop_front_n(out, count); }
 };
 
+/*
+    Comparisons walk the underlying containers with const iterators,
+    front to back, so they never copy or allocate. Equality checks
+    the sizes first and stops at the first mismatch.
+*/
+template <typename T, typename Container>
+inline bool operator==(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+        return lhs.c.size() == rhs.c.size() && std::equal(lhs.c.begin(), lhs.c.end(), rhs.c.begin());
+    }
+
+template <typename T, typename Container>
+inline bool operator!=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+        return !(lhs == rhs);
+    }
+
+// Lexicographical, oldest element first
+template <typename T, typename Container>
+inline bool operator<(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+        return std::lexicographical_compare(lhs.c.begin(), lhs.c.end(), rhs.c.begin(), rhs.c.end());
+    }
+
+template <typename T, typename Container>
+inline bool operator>(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+        return rhs < lhs;
+    }
+
+template <typename T, typename Container>
+inline bool operator<=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+        return !(rhs < lhs);
+    }
+
+template <typename T, typename Container>
+inline bool operator>=(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+        return !(lhs < rhs);
+    }
+
+#if __cplusplus >= 202002L
 template <typename T, typename Container>
-inline bool operator==(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) { 
-        if(lhs.size() == rhs.size())
-        {
-            Queue<T, Container> q1 = lhs;
-            Queue<T, Container> q2 = rhs;
-
-            for(long unsigned int index = 0; index < q1.size(); index++)
-            {
-                if(q1.front() != q2.front())
-                {
-                    return false;
-                }
-                q1.pop();
-                q2.pop();
-            }
-            return true;
-        }
-        return false;
+    requires std::three_way_comparable<T>
+inline std::compare_three_way_result_t<T> operator<=>(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
+        return std::lexicographical_compare_three_way(lhs.c.begin(), lhs.c.end(), rhs.c.begin(), rhs.c.end());
     }
+#endif
 
 #endif
\ No newline at end of file
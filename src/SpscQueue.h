@@ -0,0 +1,259 @@
+#pragma once
+
+#include <atomic> // std::atomic
+#include <cstddef> // size_t
+#include <memory> // std::allocator, std::allocator_traits
+#include <thread> // std::this_thread::yield
+#include <utility> // std::move, std::forward
+
+/*
+    A bounded single-producer/single-consumer FIFO over a ring buffer
+    whose capacity is rounded up to a power of two. One thread may
+    push and one other thread may pop; every operation completes in
+    a bounded number of steps without locks or allocation.
+
+    The producer owns the tail index and the consumer the head index,
+    each on its own cache line. Each side also keeps a cached copy of
+    the other's index and only reloads it when the cached value says
+    the ring is full (or empty), so in steady state neither side
+    touches the other's cache line.
+
+    front, pop and empty are consumer operations; push and emplace
+    are producer operations that spin while the ring is full, so the
+    queue can stand in for Queue<T> between two pipeline stages.
+
+    Example:
+    {
+        SpscQueue<int> q(1024);
+
+        std::thread producer([&] { q.push(1); });
+        producer.join();
+
+        std::cout << q.front() << std::endl; // 1
+        q.pop();
+    }
+*/
+template <class T, class Allocator = std::allocator<T>>
+class SpscQueue {
+    public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    // Written by the producer
+    alignas(64) std::atomic<size_type> _tail;
+    size_type _head_cache;
+
+    // Written by the consumer
+    alignas(64) std::atomic<size_type> _head;
+    mutable size_type _tail_cache; // refreshed by const consumer queries too
+
+    // Fixed at construction
+    alignas(64) T* _buffer;
+    size_type _mask;
+    Allocator _alloc;
+
+    static size_type round_up(size_type capacity) noexcept {
+        size_type rounded = 2;
+        while(rounded < capacity)
+        {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    T* slot(size_type index) const noexcept {
+        return _buffer + (index & _mask);
+    }
+
+    // Free slots seen by the producer, reloading the head only when needed
+    size_type free_slots(size_type tail, size_type wanted) noexcept {
+        size_type available = capacity() - (tail - _head_cache);
+        if(available < wanted)
+        {
+            _head_cache = _head.load(std::memory_order_acquire);
+            available = capacity() - (tail - _head_cache);
+        }
+        return available;
+    }
+
+    // Filled slots seen by the consumer, reloading the tail only when needed
+    size_type filled_slots(size_type head, size_type wanted) const noexcept {
+        size_type available = _tail_cache - head;
+        if(available < wanted)
+        {
+            _tail_cache = _tail.load(std::memory_order_acquire);
+            available = _tail_cache - head;
+        }
+        return available;
+    }
+
+public:
+    explicit SpscQueue( size_type capacity, const Allocator& alloc = Allocator() )
+    : _tail{0}, _head_cache{0}, _head{0}, _tail_cache{0},
+      _buffer{nullptr}, _mask{round_up(capacity) - 1}, _alloc(alloc) {
+        _buffer = alloc_traits::allocate(_alloc, _mask + 1);
+    }
+
+    // Threads share the queue by address
+    SpscQueue( const SpscQueue& other ) = delete;
+    SpscQueue& operator=( const SpscQueue& other ) = delete;
+
+    // Must not race with either side
+    ~SpscQueue() {
+        size_type tail = _tail.load();
+        for(size_type head = _head.load(); head != tail; head++)
+        {
+            alloc_traits::destroy(_alloc, slot(head));
+        }
+        alloc_traits::deallocate(_alloc, _buffer, _mask + 1);
+    }
+
+    size_type capacity() const noexcept {
+        return _mask + 1;
+    }
+
+    // Exact from either side when the other is idle, a snapshot otherwise
+    size_type size() const noexcept {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+    /*
+        Producer operations
+    */
+    template <typename... Args>
+    bool try_emplace( Args&&... args ) {
+        size_type tail = _tail.load(std::memory_order_relaxed);
+        if(free_slots(tail, 1) == 0)
+        {
+            return false;
+        }
+
+        alloc_traits::construct(_alloc, slot(tail), std::forward<Args>(args)...);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push( const T& value ) {
+        return try_emplace(value);
+    }
+    bool try_push( T&& value ) {
+        return try_emplace(std::move(value));
+    }
+
+    // Spin until there is room
+    template <typename... Args>
+    void emplace( Args&&... args ) {
+        size_type tail = _tail.load(std::memory_order_relaxed);
+        while(free_slots(tail, 1) == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        alloc_traits::construct(_alloc, slot(tail), std::forward<Args>(args)...);
+        _tail.store(tail + 1, std::memory_order_release);
+    }
+    void push( const T& value ) {
+        emplace(value);
+    }
+    void push( T&& value ) {
+        emplace(std::move(value));
+    }
+
+    // Push up to count elements from first, publishing them together.
+    // Returns the number pushed
+    template <typename InputIt>
+    size_type push_n( InputIt first, size_type count ) {
+        size_type tail = _tail.load(std::memory_order_relaxed);
+        size_type available = free_slots(tail, count);
+        if(count > available)
+        {
+            count = available;
+        }
+
+        size_type pushed = 0;
+        try
+        {
+            for(; pushed < count; pushed++, ++first)
+            {
+                alloc_traits::construct(_alloc, slot(tail + pushed), *first);
+            }
+        }
+        catch(...)
+        {
+            _tail.store(tail + pushed, std::memory_order_release);
+            throw;
+        }
+
+        _tail.store(tail + pushed, std::memory_order_release);
+        return pushed;
+    }
+
+    /*
+        Consumer operations
+    */
+    bool empty() const noexcept {
+        return filled_slots(_head.load(std::memory_order_relaxed), 1) == 0;
+    }
+
+    // The oldest element. The queue must not be empty
+    reference front() noexcept {
+        size_type head = _head.load(std::memory_order_relaxed);
+        filled_slots(head, 1);
+        return *slot(head);
+    }
+
+    void pop() noexcept {
+        size_type head = _head.load(std::memory_order_relaxed);
+        alloc_traits::destroy(_alloc, slot(head));
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    // Move the oldest element into value. Returns false if the queue was empty
+    bool try_pop( T& value ) {
+        size_type head = _head.load(std::memory_order_relaxed);
+        if(filled_slots(head, 1) == 0)
+        {
+            return false;
+        }
+
+        value = std::move(*slot(head));
+        alloc_traits::destroy(_alloc, slot(head));
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Move up to count elements to out, releasing their slots together.
+    // Returns the number popped
+    template <typename OutputIt>
+    size_type pop_n( OutputIt out, size_type count ) {
+        size_type head = _head.load(std::memory_order_relaxed);
+        size_type available = filled_slots(head, count);
+        if(count > available)
+        {
+            count = available;
+        }
+
+        size_type popped = 0;
+        try
+        {
+            for(; popped < count; popped++, ++out)
+            {
+                *out = std::move(*slot(head + popped));
+                alloc_traits::destroy(_alloc, slot(head + popped));
+            }
+        }
+        catch(...)
+        {
+            _head.store(head + popped, std::memory_order_release);
+            throw;
+        }
+
+        _head.store(head + popped, std::memory_order_release);
+        return popped;
+    }
+};
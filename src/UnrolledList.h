@@ -0,0 +1,639 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <memory> // std::allocator, std::allocator_traits
+#include <new> // placement new
+#include <utility> // std::move, std::forward
+
+#include "IteratorComparisons.h" // const/non-const iterator comparisons
+
+// Default number of elements per chunk: roughly 256 bytes of payload
+template <class T>
+constexpr size_t unrolled_chunk_capacity() {
+    return sizeof(T) >= 64 ? 4 : 256 / sizeof(T);
+}
+
+/*
+    A doubly linked list of chunks, each holding up to N elements in
+    contiguous storage. It offers the same surface as List but stores
+    many elements per allocation, so small types pay a fraction of the
+    link overhead and traversal touches far fewer cache lines.
+
+    Each chunk keeps its live elements in a window [offset, offset +
+    count) of its storage, so popping or pushing at either end of a
+    chunk only moves the window. Queue<T, UnrolledList<T>> therefore
+    pushes and pops in O(1); inserts and erases in the middle shift
+    whichever side of the chunk is shorter.
+
+    Unlike List, insert and erase may move neighbouring elements
+    within (or between) chunks, which invalidates iterators to them.
+*/
+template <class T, size_t N = unrolled_chunk_capacity<T>(), class Allocator = std::allocator<T>>
+class UnrolledList {
+    static_assert(N >= 2, "UnrolledList chunks must hold at least two elements");
+
+    private:
+    // The sentinel is a chunk without storage
+    struct ChunkBase {
+        ChunkBase *next, *prev;
+        size_t offset; // storage slot of the first live element
+        size_t count;
+    };
+
+    struct Chunk : ChunkBase {
+        alignas(T) unsigned char storage[sizeof(T) * N];
+
+        // The index-th live element
+        T* slot(size_t index) noexcept {
+            return raw(this->offset + index);
+        }
+        // Storage slot spot, live or not
+        T* raw(size_t spot) noexcept {
+            return reinterpret_cast<T*>(storage) + spot;
+        }
+    };
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+        using list_type         = UnrolledList;
+    private:
+        template <typename, typename>
+        friend class basic_iterator;
+        friend UnrolledList;
+
+        ChunkBase* chunk;
+        size_t index;
+
+        basic_iterator(ChunkBase* chunk, size_t index) noexcept : chunk{chunk}, index{index} {}
+        basic_iterator(const ChunkBase* chunk, size_t index) noexcept
+        : chunk{const_cast<ChunkBase*>(chunk)}, index{index} {}
+
+    public:
+        basic_iterator() : chunk{nullptr}, index{0} {}
+        basic_iterator(const basic_iterator&) = default;
+        basic_iterator(basic_iterator&&) = default;
+        ~basic_iterator() = default;
+        basic_iterator& operator=(const basic_iterator&) = default;
+        basic_iterator& operator=(basic_iterator&&) = default;
+
+        reference operator*() const {
+            return *static_cast<Chunk*>(chunk)->slot(index);
+        }
+        pointer operator->() const {
+            return static_cast<Chunk*>(chunk)->slot(index);
+        }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            if(++index == chunk->count)
+            {
+                chunk = chunk->next;
+                index = 0;
+            }
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            if(index == 0)
+            {
+                chunk = chunk->prev;
+                index = chunk->count;
+            }
+            index--;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        // Non-const iterators convert to const_iterator
+        template <typename P = pointer_type,
+                  typename = typename std::enable_if<!std::is_const<typename std::remove_pointer<P>::type>::value>::type>
+        operator basic_iterator<const T*, const T&>() const noexcept {
+            return basic_iterator<const T*, const T&>(chunk, index);
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept {
+            return this->chunk == other.chunk && this->index == other.index;
+        }
+        bool operator!=(const basic_iterator& other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+    static constexpr size_type chunk_capacity = N;
+
+private:
+    using chunk_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+    using chunk_traits         = std::allocator_traits<chunk_allocator_type>;
+
+    ChunkBase sentinel;
+    size_type _size;
+    chunk_allocator_type _alloc;
+
+    static Chunk* as_chunk(ChunkBase* base) noexcept {
+        return static_cast<Chunk*>(base);
+    }
+
+    // Allocate an empty chunk and link it before pos. Elements will start
+    // filling it from storage slot offset
+    Chunk* create_chunk(ChunkBase* pos, size_t offset = 0) {
+        Chunk* chunk = chunk_traits::allocate(_alloc, 1);
+        chunk->offset = offset;
+        chunk->count = 0;
+        chunk->next = pos;
+        chunk->prev = pos->prev;
+        pos->prev->next = chunk;
+        pos->prev = chunk;
+        return chunk;
+    }
+
+    // Unlink and free an empty chunk
+    void destroy_chunk(ChunkBase* chunk) noexcept {
+        chunk->prev->next = chunk->next;
+        chunk->next->prev = chunk->prev;
+        chunk_traits::deallocate(_alloc, as_chunk(chunk), 1);
+    }
+
+    // Move count elements starting at from[first] to the end of to, which
+    // must have room after its last element
+    static void transfer(Chunk* from, size_t first, size_t count, Chunk* to) {
+        for(size_t num = 0; num < count; num++)
+        {
+            T* source = from->slot(first + num);
+            ::new(static_cast<void*>(to->slot(to->count))) T(std::move(*source));
+            source->~T();
+            to->count++;
+        }
+        from->count -= count;
+    }
+
+    // Move a live element from storage slot from to the empty slot to
+    static void relocate(Chunk* chunk, size_t from, size_t to) {
+        ::new(static_cast<void*>(chunk->raw(to))) T(std::move(*chunk->raw(from)));
+        chunk->raw(from)->~T();
+    }
+
+    // Move the live elements so the first sits at storage slot offset
+    static void slide(Chunk* chunk, size_t offset) {
+        if(offset < chunk->offset)
+        {
+            for(size_t index = 0; index < chunk->count; index++)
+            {
+                relocate(chunk, chunk->offset + index, offset + index);
+            }
+        }
+        else
+        {
+            for(size_t index = chunk->count; index > 0; index--)
+            {
+                relocate(chunk, chunk->offset + index - 1, offset + index - 1);
+            }
+        }
+        chunk->offset = offset;
+    }
+
+    // Open a gap at index in a non-full chunk. Pushes at either end only
+    // move the window; otherwise the shorter side shifts, after sliding
+    // the elements over if that side has no free slot left
+    static void open_gap(Chunk* chunk, size_t index) {
+        bool front = index < chunk->count - index;
+        if(index == 0 && chunk->offset > 0)
+        {
+            front = true;
+        }
+        else if(index == chunk->count && chunk->offset + chunk->count < N)
+        {
+            front = false;
+        }
+
+        if(front)
+        {
+            if(chunk->offset == 0)
+            {
+                slide(chunk, N - chunk->count);
+            }
+            for(size_t spot = chunk->offset; spot < chunk->offset + index; spot++)
+            {
+                relocate(chunk, spot, spot - 1);
+            }
+            chunk->offset--;
+        }
+        else
+        {
+            if(chunk->offset + chunk->count == N)
+            {
+                slide(chunk, 0);
+            }
+            for(size_t spot = chunk->offset + chunk->count; spot > chunk->offset + index; spot--)
+            {
+                relocate(chunk, spot - 1, spot);
+            }
+        }
+    }
+
+    // Close the gap at index, counted in count, by shifting the shorter side
+    // over it. The caller then drops count by one
+    static void close_gap(Chunk* chunk, size_t index) {
+        if(index < chunk->count - 1 - index)
+        {
+            for(size_t spot = chunk->offset + index; spot > chunk->offset; spot--)
+            {
+                relocate(chunk, spot - 1, spot);
+            }
+            chunk->offset++;
+        }
+        else
+        {
+            for(size_t spot = chunk->offset + index; spot + 1 < chunk->offset + chunk->count; spot++)
+            {
+                relocate(chunk, spot + 1, spot);
+            }
+        }
+    }
+
+    // Find a chunk with room for an element at (chunk, index), splitting if needed.
+    // Returns the position the element should be constructed at.
+    iterator make_room(ChunkBase* chunk, size_t index) {
+        if(chunk == &sentinel)
+        {
+            // Appending: fill the last chunk's free tail before starting a new one
+            chunk = sentinel.prev;
+            if(chunk == &sentinel || chunk->offset + chunk->count == N)
+            {
+                return iterator(create_chunk(&sentinel), 0);
+            }
+            return iterator(chunk, chunk->count);
+        }
+
+        if(chunk->count < N)
+        {
+            return iterator(chunk, index);
+        }
+
+        if(index == 0)
+        {
+            // Prepending to a full chunk: use the spare room of the previous one
+            ChunkBase* prev = chunk->prev;
+            if(prev != &sentinel && prev->count < N)
+            {
+                return iterator(prev, prev->count);
+            }
+            // Fill the new chunk from its back so further prepends are O(1)
+            return iterator(create_chunk(chunk, N), 0);
+        }
+
+        // Split the full chunk in half
+        Chunk* full = as_chunk(chunk);
+        Chunk* back = create_chunk(chunk->next);
+        transfer(full, N / 2, N - N / 2, back);
+
+        if(index > full->count)
+        {
+            return iterator(back, index - full->count);
+        }
+        return iterator(full, index);
+    }
+
+    template <typename... Args>
+    iterator construct_at(const_iterator pos, Args&&... args) {
+        iterator spot = make_room(pos.chunk, pos.index);
+        Chunk* chunk = as_chunk(spot.chunk);
+
+        open_gap(chunk, spot.index);
+        try {
+            ::new(static_cast<void*>(chunk->slot(spot.index))) T(std::forward<Args>(args)...);
+        }
+        catch(...) {
+            // Count the gap so close_gap shifts its neighbours back over it
+            chunk->count++;
+            close_gap(chunk, spot.index);
+            chunk->count--;
+            if(chunk->count == 0)
+            {
+                destroy_chunk(chunk);
+            }
+            throw;
+        }
+        chunk->count++;
+        _size++;
+
+        return spot;
+    }
+
+    // Point the sentinel at itself
+    void reset_sentinel() noexcept {
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
+        sentinel.offset = 0;
+        sentinel.count = 0;
+    }
+
+    // Take ownership of other's chunks. Both lists must share an allocator
+    void steal_chunks(UnrolledList& other) noexcept {
+        _size = other._size;
+        if(_size > 0)
+        {
+            sentinel.next = other.sentinel.next;
+            sentinel.prev = other.sentinel.prev;
+            sentinel.next->prev = &sentinel;
+            sentinel.prev->next = &sentinel;
+        }
+        else
+        {
+            reset_sentinel();
+        }
+
+        other.reset_sentinel();
+        other._size = 0;
+    }
+
+public:
+    UnrolledList(): UnrolledList(Allocator()) {}
+    explicit UnrolledList( const Allocator& alloc ): _size(0), _alloc(alloc) {
+        reset_sentinel();
+    }
+    UnrolledList( size_type count, const T& value, const Allocator& alloc = Allocator() ): UnrolledList(alloc) {
+        for(size_type num = 0; num < count; num++)
+        {
+            push_back(value);
+        }
+    }
+    explicit UnrolledList( size_type count, const Allocator& alloc = Allocator() ): UnrolledList(alloc) {
+        for(size_type num = 0; num < count; num++)
+        {
+            emplace_back();
+        }
+    }
+    UnrolledList( const UnrolledList& other )
+    : UnrolledList(chunk_traits::select_on_container_copy_construction(other._alloc)) {
+        for(const_iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+        {
+            push_back(*currentSpot);
+        }
+    }
+    UnrolledList( UnrolledList&& other ): _size(0), _alloc(std::move(other._alloc)) {
+        steal_chunks(other);
+    }
+    ~UnrolledList() {
+        clear();
+    }
+    UnrolledList& operator=( const UnrolledList& other ) {
+        if(this != &other)
+        {
+            clear();
+            if(chunk_traits::propagate_on_container_copy_assignment::value)
+            {
+                _alloc = other._alloc;
+            }
+
+            for(const_iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+            {
+                push_back(*currentSpot);
+            }
+        }
+        return *this;
+    }
+    UnrolledList& operator=( UnrolledList&& other ) noexcept(
+        chunk_traits::propagate_on_container_move_assignment::value || chunk_traits::is_always_equal::value) {
+        if(this != &other)
+        {
+            clear();
+            if(chunk_traits::propagate_on_container_move_assignment::value)
+            {
+                _alloc = std::move(other._alloc);
+            }
+
+            if(chunk_traits::propagate_on_container_move_assignment::value || _alloc == other._alloc)
+            {
+                steal_chunks(other);
+            }
+            else
+            {
+                for(iterator currentSpot = other.begin(); currentSpot != other.end(); currentSpot++)
+                {
+                    push_back(std::move(*currentSpot));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(_alloc);
+    }
+
+    reference front() {
+        return *as_chunk(sentinel.next)->slot(0);
+    }
+    const_reference front() const {
+        return *static_cast<const Chunk*>(sentinel.next)->slot(0);
+    }
+
+    reference back() {
+        Chunk* last = as_chunk(sentinel.prev);
+        return *last->slot(last->count - 1);
+    }
+    const_reference back() const {
+        Chunk* last = as_chunk(sentinel.prev);
+        return *last->slot(last->count - 1);
+    }
+
+    iterator begin() noexcept {
+        return iterator(sentinel.next, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(sentinel.next, 0);
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(sentinel.next, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(&sentinel, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(&sentinel, 0);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(&sentinel, 0);
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    void clear() noexcept {
+        ChunkBase* currentChunk = sentinel.next;
+        while(currentChunk != &sentinel)
+        {
+            Chunk* chunk = as_chunk(currentChunk);
+            currentChunk = currentChunk->next;
+
+            for(size_t index = 0; index < chunk->count; index++)
+            {
+                chunk->slot(index)->~T();
+            }
+            chunk_traits::deallocate(_alloc, chunk, 1);
+        }
+
+        reset_sentinel();
+        _size = 0;
+    }
+
+    iterator insert( const_iterator pos, const T& value ) {
+        return construct_at(pos, value);
+    }
+    iterator insert( const_iterator pos, T&& value ) {
+        return construct_at(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    iterator emplace( const_iterator pos, Args&&... args ) {
+        return construct_at(pos, std::forward<Args>(args)...);
+    }
+
+    iterator erase( const_iterator pos ) {
+        Chunk* chunk = as_chunk(pos.chunk);
+        size_t index = pos.index;
+
+        chunk->slot(index)->~T();
+        close_gap(chunk, index);
+        chunk->count--;
+        _size--;
+
+        if(chunk->count == 0)
+        {
+            ChunkBase* next = chunk->next;
+            destroy_chunk(chunk);
+            return iterator(next, 0);
+        }
+
+        // Fold a sparse neighbour in so chunks stay at least a quarter full
+        ChunkBase* next = chunk->next;
+        if(next != &sentinel && chunk->count + next->count <= N / 2)
+        {
+            if(chunk->offset + chunk->count + next->count > N)
+            {
+                slide(chunk, 0);
+            }
+            transfer(as_chunk(next), 0, next->count, chunk);
+            destroy_chunk(next);
+        }
+
+        if(index == chunk->count)
+        {
+            return iterator(chunk->next, 0);
+        }
+        return iterator(chunk, index);
+    }
+
+    void push_back( const T& value ) {
+        construct_at(cend(), value);
+    }
+    void push_back( T&& value ) {
+        construct_at(cend(), std::move(value));
+    }
+
+    template <typename... Args>
+    reference emplace_back( Args&&... args ) {
+        return *construct_at(cend(), std::forward<Args>(args)...);
+    }
+
+    void pop_back() {
+        erase(--cend());
+    }
+
+    void push_front( const T& value ) {
+        construct_at(cbegin(), value);
+    }
+    void push_front( T&& value ) {
+        construct_at(cbegin(), std::move(value));
+    }
+
+    template <typename... Args>
+    reference emplace_front( Args&&... args ) {
+        return *construct_at(cbegin(), std::forward<Args>(args)...);
+    }
+
+    void pop_front() {
+        erase(cbegin());
+    }
+
+    // Exchange contents in O(1). Allocators are swapped only if they propagate
+    void swap( UnrolledList& other ) noexcept {
+        if(this == &other)
+        {
+            return;
+        }
+
+        if(chunk_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        ChunkBase *first = sentinel.next, *last = sentinel.prev;
+        size_type count = _size;
+
+        steal_chunks(other);
+        if(count > 0)
+        {
+            other.sentinel.next = first;
+            other.sentinel.prev = last;
+            first->prev = &(other.sentinel);
+            last->next = &(other.sentinel);
+        }
+        other._size = count;
+    }
+
+    iterator insert( iterator pos, const T & value) {
+        return insert(const_iterator(pos), value);
+    }
+
+    iterator insert( iterator pos, T && value ) {
+        return insert(const_iterator(pos), std::move(value));
+    }
+
+    iterator erase( iterator pos ) {
+        return erase(const_iterator(pos));
+    }
+};
+
+template <class T, size_t N, class Allocator>
+void swap(UnrolledList<T, N, Allocator>& lhs, UnrolledList<T, N, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
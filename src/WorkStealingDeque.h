@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic> // std::atomic, std::atomic_thread_fence
+#include <cstddef> // size_t, ptrdiff_t
+#include <memory> // std::allocator, std::allocator_traits
+#include <new> // placement new
+#include <type_traits> // std::is_trivially_copyable
+
+/*
+    A Chase-Lev work-stealing deque. One owner thread pushes and pops
+    at the bottom, last in first out, while any number of thieves
+    take from the top, first in first out. The owner only contends
+    with thieves over the last element, so in the common case push
+    and pop are a few plain loads and stores.
+
+    The ring grows when the owner pushes onto a full one. Thieves may
+    still be reading the old ring, so it is kept until the deque is
+    destroyed; the retired rings add up to less than the live one.
+
+    T is copied through atomics and must be trivially copyable,
+    typically a pointer to the task.
+
+    Example:
+    {
+        WorkStealingDeque<Task*> tasks;
+
+        tasks.push(task);               // owner
+
+        Task* next;
+        if(tasks.pop(next))             // owner, newest first
+            run(next);
+        if(tasks.steal(next))           // any thread, oldest first
+            run(next);
+    }
+*/
+template <class T, class Allocator = std::allocator<T>>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque elements must be trivially copyable");
+
+    public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+
+    private:
+    struct Ring {
+        size_type mask;
+        std::atomic<T>* slots;
+        Ring* retired; // the ring this one replaced
+
+        T load(ptrdiff_t index) const noexcept {
+            return slots[index & mask].load(std::memory_order_relaxed);
+        }
+        void store(ptrdiff_t index, T value) noexcept {
+            slots[index & mask].store(value, std::memory_order_relaxed);
+        }
+    };
+
+    using slot_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<T>>;
+    using slot_traits         = std::allocator_traits<slot_allocator_type>;
+    using ring_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Ring>;
+    using ring_traits         = std::allocator_traits<ring_allocator_type>;
+
+    // Thieves contend on the top, the owner alone writes the bottom
+    alignas(64) std::atomic<ptrdiff_t> _top;
+    alignas(64) std::atomic<ptrdiff_t> _bottom;
+    std::atomic<Ring*> _ring;
+    slot_allocator_type _alloc;
+
+    Ring* create_ring(size_type capacity, Ring* retired) {
+        ring_allocator_type ring_alloc(_alloc);
+        Ring* ring = ring_traits::allocate(ring_alloc, 1);
+        ring->mask = capacity - 1;
+        ring->retired = retired;
+        try
+        {
+            ring->slots = slot_traits::allocate(_alloc, capacity);
+        }
+        catch(...)
+        {
+            ring_traits::deallocate(ring_alloc, ring, 1);
+            throw;
+        }
+        for(size_type index = 0; index < capacity; index++)
+        {
+            ::new(static_cast<void*>(ring->slots + index)) std::atomic<T>();
+        }
+        return ring;
+    }
+
+    void destroy_ring(Ring* ring) noexcept {
+        ring_allocator_type ring_alloc(_alloc);
+        slot_traits::deallocate(_alloc, ring->slots, ring->mask + 1);
+        ring_traits::deallocate(ring_alloc, ring, 1);
+    }
+
+    // Copy the live range into a ring twice the size. Owner only
+    Ring* grow(Ring* ring, ptrdiff_t top, ptrdiff_t bottom) {
+        Ring* larger = create_ring(2 * (ring->mask + 1), ring);
+        for(ptrdiff_t index = top; index < bottom; index++)
+        {
+            larger->store(index, ring->load(index));
+        }
+        _ring.store(larger, std::memory_order_release);
+        return larger;
+    }
+
+public:
+    explicit WorkStealingDeque( size_type capacity = 64, const Allocator& alloc = Allocator() )
+    : _top{0}, _bottom{0}, _ring{nullptr}, _alloc(alloc) {
+        size_type rounded = 2;
+        while(rounded < capacity)
+        {
+            rounded *= 2;
+        }
+        _ring.store(create_ring(rounded, nullptr), std::memory_order_relaxed);
+    }
+
+    // Threads share the deque by address
+    WorkStealingDeque( const WorkStealingDeque& other ) = delete;
+    WorkStealingDeque& operator=( const WorkStealingDeque& other ) = delete;
+
+    // Must not race with any other operation
+    ~WorkStealingDeque() {
+        Ring* ring = _ring.load();
+        while(ring != nullptr)
+        {
+            Ring* retired = ring->retired;
+            destroy_ring(ring);
+            ring = retired;
+        }
+    }
+
+    // A snapshot; exact only when no other thread is active
+    size_type size() const noexcept {
+        ptrdiff_t bottom = _bottom.load(std::memory_order_relaxed);
+        ptrdiff_t top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_type capacity() const noexcept {
+        return _ring.load(std::memory_order_relaxed)->mask + 1;
+    }
+
+    // Owner only
+    void push( T value ) {
+        ptrdiff_t bottom = _bottom.load(std::memory_order_relaxed);
+        ptrdiff_t top = _top.load(std::memory_order_acquire);
+        Ring* ring = _ring.load(std::memory_order_relaxed);
+        if(bottom - top > static_cast<ptrdiff_t>(ring->mask))
+        {
+            ring = grow(ring, top, bottom);
+        }
+
+        ring->store(bottom, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only. Takes the newest element; returns false if there was none
+    bool pop( T& value ) {
+        ptrdiff_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        Ring* ring = _ring.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        ptrdiff_t top = _top.load(std::memory_order_relaxed);
+
+        if(top > bottom)
+        {
+            // Already empty
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        T taken = ring->load(bottom);
+        if(top == bottom)
+        {
+            // The last element: race the thieves for it
+            bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            if(!won)
+            {
+                return false;
+            }
+        }
+        value = taken;
+        return true;
+    }
+
+    // Any thread. Takes the oldest element; returns false if there was
+    // none or another thread took it first
+    bool steal( T& value ) {
+        ptrdiff_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        ptrdiff_t bottom = _bottom.load(std::memory_order_acquire);
+
+        if(top >= bottom)
+        {
+            return false;
+        }
+
+        Ring* ring = _ring.load(std::memory_order_acquire);
+        T taken = ring->load(top);
+        if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return false;
+        }
+        value = taken;
+        return true;
+    }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+/*
+    Minimal timing helpers shared by the benchmarks. Each benchmark
+    is its own executable; results are printed one per line as
+
+        <name>  <operations per second>  <nanoseconds per operation>
+
+    Example:
+    {
+        double seconds = time_seconds([&] { run(); });
+        report("queue/push", ops, seconds);
+    }
+*/
+
+// Wall-clock time taken by fn, in seconds
+template<typename Fn>
+double time_seconds(Fn && fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+// Best of several runs, which filters out scheduler noise
+template<typename Fn>
+double best_of(size_t runs, Fn && fn) {
+    double best = time_seconds(fn);
+    for(size_t run = 1; run < runs; run++) {
+        double seconds = time_seconds(fn);
+        if(seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+inline void report(char const * name, size_t ops, double seconds) {
+    std::printf("%-40s %14.0f ops/s %10.2f ns/op\n", name, ops / seconds, seconds * 1e9 / ops);
+}
+
+// Keep the optimiser from discarding a computed value
+template<typename T>
+void do_not_optimize(T const & value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
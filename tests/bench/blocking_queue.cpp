@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "BlockingQueue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/*
+    Two producers feed two consumers through a BlockingQueue. The
+    consumers either take one element per lock acquisition with
+    pop_wait, or drain up to a batch at a time with pop_batch. Each
+    consumer pop is one lock round-trip, so the number of pops per
+    element shows how far batching cuts them.
+*/
+
+constexpr size_t ops = 1 << 20;
+constexpr size_t runs = 3;
+constexpr size_t producers = 2, consumers = 2;
+
+template<typename Consume>
+double run(size_t & lock_trips, Consume consume) {
+    return best_of(runs, [&] {
+        BlockingQueue<size_t> q;
+        std::vector<size_t> trips(consumers, 0);
+
+        std::vector<std::thread> pool;
+        for(size_t p = 0; p < producers; p++) {
+            pool.emplace_back([&] {
+                for(size_t i = 0; i < ops / producers; i++)
+                    q.push(i);
+            });
+        }
+        for(size_t c = 0; c < consumers; c++)
+            pool.emplace_back([&, c] { trips[c] = consume(q); });
+
+        for(size_t p = 0; p < producers; p++)
+            pool[p].join();
+        q.close();
+        for(size_t c = 0; c < consumers; c++)
+            pool[producers + c].join();
+
+        lock_trips = 0;
+        for(size_t count : trips)
+            lock_trips += count;
+    });
+}
+
+int main() {
+    size_t trips = 0;
+    char name[64];
+
+    double seconds = run(trips, [](BlockingQueue<size_t> & q) {
+        size_t value, sum = 0, pops = 0;
+        while(q.pop_wait(value)) {
+            sum += value;
+            pops++;
+        }
+        do_not_optimize(sum);
+        return pops;
+    });
+    report("BlockingQueue pop_wait", ops, seconds);
+    std::printf("%-40s %14.3f pops/element\n", "", double(trips) / ops);
+
+    for(size_t batch : { 16, 64, 256 }) {
+        seconds = run(trips, [batch](BlockingQueue<size_t> & q) {
+            std::vector<size_t> values(batch);
+            size_t count, sum = 0, pops = 0;
+            while((count = q.pop_batch(values.begin(), batch, std::chrono::seconds(1))) > 0) {
+                for(size_t j = 0; j < count; j++)
+                    sum += values[j];
+                pops++;
+            }
+            do_not_optimize(sum);
+            return pops;
+        });
+
+        std::snprintf(name, sizeof(name), "BlockingQueue pop_batch(%zu)", batch);
+        report(name, ops, seconds);
+        std::printf("%-40s %14.3f pops/element\n", "", double(trips) / ops);
+    }
+}
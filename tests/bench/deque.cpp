@@ -0,0 +1,44 @@
+#include "bench.h"
+#include "Deque.h"
+#include "Queue.h"
+
+#include <cstdio>
+
+/*
+    A single-threaded FIFO holding a steady number of elements, fed
+    through Queue over its default List and over Deque. List pays an
+    allocation and a free per element; Deque recycles its blocks, so
+    after warm-up it runs without touching the allocator.
+*/
+
+constexpr size_t ops = 1 << 22;
+constexpr size_t runs = 3;
+
+template<typename Q>
+double run(size_t depth) {
+    return best_of(runs, [&] {
+        Q q;
+        for(size_t i = 0; i < depth; i++)
+            q.push(i);
+
+        size_t sum = 0;
+        for(size_t i = 0; i < ops; i++) {
+            q.push(i);
+            sum += q.front();
+            q.pop();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+int main() {
+    char name[64];
+
+    for(size_t depth : { 16, 1024, 65536 }) {
+        std::snprintf(name, sizeof(name), "queue<list>/depth=%zu", depth);
+        report(name, ops, run<Queue<size_t>>(depth));
+
+        std::snprintf(name, sizeof(name), "queue<deque>/depth=%zu", depth);
+        report(name, ops, run<Queue<size_t, Deque<size_t>>>(depth));
+    }
+}
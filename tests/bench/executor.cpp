@@ -0,0 +1,120 @@
+#include "bench.h"
+#include "Executor.h"
+#include "Queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Fork-join at 1 to 16 threads: every task splits its range in two
+    child tasks until the range holds a single leaf, which does a
+    little arithmetic. The baseline is the pool the Executor replaces,
+    workers sharing one Queue<std::function<void()>> behind a mutex.
+*/
+
+constexpr size_t leaves = 1 << 16;
+constexpr size_t runs = 3;
+
+// Every worker takes tasks from one shared, locked Queue
+class SharedQueuePool {
+    Queue<std::function<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable ready, idle;
+    std::vector<std::thread> workers;
+    size_t pending = 0;
+    bool stopping = false;
+
+    void run() {
+        while(true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> held(lock);
+                ready.wait(held, [this] { return !tasks.empty() || stopping; });
+                if(tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+
+            task();
+
+            std::lock_guard<std::mutex> held(lock);
+            if(--pending == 0)
+                idle.notify_all();
+        }
+    }
+
+    public:
+    explicit SharedQueuePool(size_t threads) {
+        for(size_t i = 0; i < threads; i++)
+            workers.emplace_back([this] { run(); });
+    }
+
+    ~SharedQueuePool() {
+        {
+            std::lock_guard<std::mutex> held(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for(std::thread & worker : workers)
+            worker.join();
+    }
+
+    template<typename Fn>
+    void submit(Fn && fn) {
+        std::lock_guard<std::mutex> held(lock);
+        tasks.push(std::function<void()>(std::forward<Fn>(fn)));
+        pending++;
+        ready.notify_one();
+    }
+
+    void wait_idle() {
+        std::unique_lock<std::mutex> held(lock);
+        idle.wait(held, [this] { return pending == 0; });
+    }
+};
+
+template<typename Pool>
+void fork(Pool & pool, std::atomic<size_t> & sum, size_t first, size_t last) {
+    if(last - first == 1) {
+        size_t value = first;
+        for(size_t i = 0; i < 64; i++)
+            value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        sum.fetch_add(value & 1, std::memory_order_relaxed);
+        return;
+    }
+
+    const size_t middle = first + (last - first) / 2;
+    pool.submit([&pool, &sum, first, middle] { fork(pool, sum, first, middle); });
+    pool.submit([&pool, &sum, middle, last] { fork(pool, sum, middle, last); });
+}
+
+// Tasks run per second, counting the inner nodes of the tree
+template<typename Pool>
+double fork_join(size_t threads) {
+    Pool pool(threads);
+    return best_of(runs, [&] {
+        std::atomic<size_t> sum { 0 };
+        pool.submit([&] { fork(pool, sum, 0, leaves); });
+        pool.wait_idle();
+        do_not_optimize(sum.load());
+    });
+}
+
+int main() {
+    char name[64];
+    const size_t tasks = 2 * leaves - 1;
+
+    for(size_t threads = 1; threads <= 16; threads *= 2) {
+        std::snprintf(name, sizeof(name), "shared Queue pool  %2zu threads", threads);
+        report(name, tasks, fork_join<SharedQueuePool>(threads));
+
+        std::snprintf(name, sizeof(name), "Executor           %2zu threads", threads);
+        report(name, tasks, fork_join<Executor>(threads));
+    }
+}
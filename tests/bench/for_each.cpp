@@ -0,0 +1,91 @@
+#include "bench.h"
+#include "List.h"
+#include "PrefetchingIterator.h"
+
+#include <cstdio>
+
+/*
+    One pass over a 10M-element List whose nodes are scattered across
+    the heap: the nodes are allocated in order with random values and
+    then sorted, which relinks them in random address order. Each
+    element gets Rounds rounds of arithmetic, the work the lead
+    pointer's cache misses can overlap with: with light work the walk
+    stays bound by one miss per node however far ahead it prefetches,
+    while heavier work hides most of the miss. The plain iterator is
+    the baseline; for_each and prefetching_iterator run at several
+    prefetch distances. The sequential layout is shown for reference.
+*/
+
+constexpr size_t elements = 10000000;
+constexpr size_t runs = 3;
+
+template<size_t Rounds>
+inline size_t work(size_t value) {
+    for(size_t i = 0; i < Rounds; i++)
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+    return value;
+}
+
+template<size_t Rounds>
+double plain(List<size_t> const & ll) {
+    return best_of(runs, [&] {
+        size_t sum = 0;
+        for(List<size_t>::const_iterator it = ll.begin(); it != ll.end(); ++it)
+            sum += work<Rounds>(*it);
+        do_not_optimize(sum);
+    });
+}
+
+template<size_t Rounds, size_t Distance>
+double for_each(List<size_t> const & ll) {
+    return best_of(runs, [&] {
+        size_t sum = 0;
+        ll.for_each<Distance>([&](size_t value) { sum += work<Rounds>(value); });
+        do_not_optimize(sum);
+    });
+}
+
+template<size_t Rounds, size_t Distance>
+double adaptor(List<size_t> const & ll) {
+    using Iter = prefetching_iterator<List<size_t>::const_iterator, Distance>;
+    return best_of(runs, [&] {
+        size_t sum = 0;
+        for(Iter it(ll.begin(), ll.end()), last(ll.end(), ll.end()); it != last; ++it)
+            sum += work<Rounds>(*it);
+        do_not_optimize(sum);
+    });
+}
+
+template<size_t Rounds>
+void report_all(char const * layout, List<size_t> const & ll) {
+    char name[64];
+
+    std::snprintf(name, sizeof(name), "%s/work=%zu/iterator", layout, Rounds);
+    report(name, elements, plain<Rounds>(ll));
+
+    std::snprintf(name, sizeof(name), "%s/work=%zu/for_each<0>", layout, Rounds);
+    report(name, elements, for_each<Rounds, 0>(ll));
+    std::snprintf(name, sizeof(name), "%s/work=%zu/for_each<4>", layout, Rounds);
+    report(name, elements, for_each<Rounds, 4>(ll));
+    std::snprintf(name, sizeof(name), "%s/work=%zu/for_each<8>", layout, Rounds);
+    report(name, elements, for_each<Rounds, 8>(ll));
+    std::snprintf(name, sizeof(name), "%s/work=%zu/for_each<16>", layout, Rounds);
+    report(name, elements, for_each<Rounds, 16>(ll));
+
+    std::snprintf(name, sizeof(name), "%s/work=%zu/prefetching_iterator<8>", layout, Rounds);
+    report(name, elements, adaptor<Rounds, 8>(ll));
+}
+
+int main() {
+    List<size_t> ll;
+    size_t value = 1;
+    for(size_t i = 0; i < elements; i++) {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        ll.push_back(value >> 16);
+    }
+
+    report_all<4>("sequential", ll);
+    ll.sort();
+    report_all<4>("scattered", ll);
+    report_all<64>("scattered", ll);
+}
@@ -0,0 +1,110 @@
+#include "bench.h"
+#include "MpmcQueue.h"
+#include "Queue.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Contention at 1 to 64 threads: half the threads push and half pop
+    a fixed number of integers through a bounded queue. The baseline
+    is the pattern MpmcQueue replaces, a Queue<T> behind a mutex with
+    a size check bolted on for admission control.
+*/
+
+constexpr size_t ops = 1 << 20;
+constexpr size_t runs = 3;
+constexpr size_t bound = 1024;
+
+// A Queue<T> guarded by a mutex, refusing pushes beyond capacity
+class LockedQueue {
+    Queue<size_t> q;
+    std::mutex lock;
+
+    public:
+    bool try_push(size_t value) {
+        std::lock_guard<std::mutex> guard(lock);
+        if(q.size() >= bound)
+            return false;
+        q.push(value);
+        return true;
+    }
+
+    bool try_pop(size_t & value) {
+        std::lock_guard<std::mutex> guard(lock);
+        if(q.empty())
+            return false;
+        value = q.front();
+        q.pop();
+        return true;
+    }
+};
+
+// Split ops between producers and consumers. A single thread alternates
+template<typename QueueType>
+double contend(size_t threads) {
+    return best_of(runs, [threads] {
+        QueueType q;
+
+        if(threads == 1) {
+            size_t value = 0, sum = 0;
+            for(size_t i = 0; i < ops; i++) {
+                q.try_push(i);
+                q.try_pop(value);
+                sum += value;
+            }
+            do_not_optimize(sum);
+            return;
+        }
+
+        const size_t producers = threads / 2;
+        const size_t consumers = threads - producers;
+        const size_t per_producer = ops / producers;
+        std::atomic<size_t> consumed { 0 };
+
+        std::vector<std::thread> pool;
+        for(size_t p = 0; p < producers; p++) {
+            pool.emplace_back([&] {
+                for(size_t i = 0; i < per_producer; )
+                    if(q.try_push(i))
+                        i++;
+                    else
+                        std::this_thread::yield();
+            });
+        }
+        for(size_t c = 0; c < consumers; c++) {
+            pool.emplace_back([&] {
+                size_t value, sum = 0;
+                while(consumed.load(std::memory_order_relaxed) < per_producer * producers) {
+                    if(q.try_pop(value)) {
+                        sum += value;
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                do_not_optimize(sum);
+            });
+        }
+        for(std::thread & thread : pool)
+            thread.join();
+    });
+}
+
+struct BoundedMpmc : MpmcQueue<size_t> {
+    BoundedMpmc() : MpmcQueue<size_t>(bound) {}
+};
+
+int main() {
+    char name[64];
+    for(size_t threads = 1; threads <= 64; threads *= 2) {
+        std::snprintf(name, sizeof(name), "mutex + Queue<size_t>  %2zu threads", threads);
+        report(name, ops, contend<LockedQueue>(threads));
+
+        std::snprintf(name, sizeof(name), "MpmcQueue<size_t>      %2zu threads", threads);
+        report(name, ops, contend<BoundedMpmc>(threads));
+    }
+}
@@ -0,0 +1,101 @@
+#include "bench.h"
+#include "List.h"
+#include "NodeCacheAllocator.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Producer/consumer pairs, 1 to 8 of them, each pair sharing one
+    channel. A producer builds a batch of nodes in a private list and
+    splices it into the channel; its consumer splices everything out
+    and pops it, so every node is freed by a thread other than the
+    one that allocated it. The baseline allocates nodes with
+    std::allocator; NodeCacheAllocator returns them to the producer a
+    magazine at a time.
+*/
+
+constexpr size_t per_pair = 1 << 18;
+constexpr size_t batch = 256;
+constexpr size_t runs = 3;
+
+template<typename ListType>
+struct Channel {
+    ListType items;
+    std::mutex lock;
+    std::condition_variable ready;
+    bool done = false;
+};
+
+template<typename ListType>
+void produce(Channel<ListType> & channel) {
+    ListType local;
+    for(size_t sent = 0; sent < per_pair; ) {
+        for(size_t i = 0; i < batch; i++)
+            local.push_back(static_cast<int>(sent + i));
+        sent += batch;
+
+        std::lock_guard<std::mutex> held(channel.lock);
+        channel.items.splice(channel.items.end(), local);
+        channel.ready.notify_one();
+    }
+
+    std::lock_guard<std::mutex> held(channel.lock);
+    channel.done = true;
+    channel.ready.notify_one();
+}
+
+template<typename ListType>
+void consume(Channel<ListType> & channel) {
+    ListType local;
+    long sum = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> held(channel.lock);
+            channel.ready.wait(held, [&] { return !channel.items.empty() || channel.done; });
+            if(channel.items.empty())
+                break;
+            local.splice(local.end(), channel.items);
+        }
+
+        while(!local.empty()) {
+            sum += local.front();
+            local.pop_front();
+        }
+    }
+    do_not_optimize(sum);
+}
+
+// Elements passed per second over all pairs
+template<typename ListType>
+double pairs(size_t count) {
+    return best_of(runs, [&] {
+        std::vector<std::unique_ptr<Channel<ListType>>> channels;
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < count; i++)
+            channels.emplace_back(new Channel<ListType>);
+
+        for(size_t i = 0; i < count; i++) {
+            threads.emplace_back([&, i] { consume(*channels[i]); });
+            threads.emplace_back([&, i] { produce(*channels[i]); });
+        }
+        for(std::thread & thread : threads)
+            thread.join();
+    });
+}
+
+int main() {
+    char name[64];
+
+    for(size_t count = 1; count <= 8; count *= 2) {
+        std::snprintf(name, sizeof(name), "std::allocator      %zu pairs", count);
+        report(name, count * per_pair, pairs<List<int>>(count));
+
+        std::snprintf(name, sizeof(name), "NodeCacheAllocator  %zu pairs", count);
+        report(name, count * per_pair, pairs<List<int, NodeCacheAllocator<int>>>(count));
+    }
+}
@@ -0,0 +1,91 @@
+#include "bench.h"
+#include "List.h"
+
+#include <cstdint>
+#include <cstdio>
+
+/*
+    Every node layout policy against payloads of 4 to 256 bytes. For
+    each pair it reports the bytes a node occupies per element, a full
+    iteration over a list of 1M elements built one push_back at a time,
+    and a steady FIFO of push_back/pop_front. Payloads are arrays of 16
+    bit words, so the 6 byte one packs in behind the 16 bit slab index.
+*/
+
+constexpr size_t elements = 1 << 20;
+constexpr size_t ops = 1 << 22;
+constexpr size_t depth = 1024;
+constexpr size_t runs = 3;
+
+template<size_t Bytes>
+struct Payload {
+    uint16_t words[Bytes / 2];
+
+    Payload(size_t value = 0) : words {} { words[0] = static_cast<uint16_t>(value); }
+};
+
+template<size_t Bytes, typename Layout>
+using LayoutList = List<Payload<Bytes>, std::allocator<Payload<Bytes>>, Layout>;
+
+template<typename ListType>
+double iterate(ListType const & ll) {
+    return best_of(runs, [&] {
+        uint32_t sum = 0;
+        for(auto const & value : ll)
+            sum += value.words[0];
+        do_not_optimize(sum);
+    });
+}
+
+template<typename ListType>
+double push_pop() {
+    return best_of(runs, [&] {
+        ListType ll;
+        for(size_t i = 0; i < depth; i++)
+            ll.push_back(i);
+
+        uint32_t sum = 0;
+        for(size_t i = 0; i < ops; i++) {
+            ll.push_back(i);
+            sum += ll.front().words[0];
+            ll.pop_front();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+template<size_t Bytes, typename Layout>
+void run(char const * layout) {
+    using ListType = LayoutList<Bytes, Layout>;
+    char name[64];
+
+    std::snprintf(name, sizeof(name), "%s/T=%zuB/memory", layout, Bytes);
+    std::printf("%-40s %14zu bytes/element\n", name, ListType::node_size);
+
+    {
+        ListType ll;
+        for(size_t i = 0; i < elements; i++)
+            ll.push_back(i);
+
+        std::snprintf(name, sizeof(name), "%s/T=%zuB/iterate", layout, Bytes);
+        report(name, elements, iterate(ll));
+    }
+
+    std::snprintf(name, sizeof(name), "%s/T=%zuB/push_pop", layout, Bytes);
+    report(name, ops, push_pop<ListType>());
+}
+
+template<size_t Bytes>
+void run_layouts() {
+    run<Bytes, pointers_first_layout>("pointers_first");
+    run<Bytes, data_first_layout>("data_first");
+    run<Bytes, cache_line_layout>("cache_line");
+}
+
+int main() {
+    run_layouts<4>();
+    run_layouts<6>();
+    run_layouts<16>();
+    run_layouts<64>();
+    run_layouts<256>();
+}
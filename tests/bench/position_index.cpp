@@ -0,0 +1,112 @@
+#include "bench.h"
+#include "List.h"
+
+#include <cstdio>
+#include <iterator>
+
+/*
+    "Jump to row k" on lists of 1K to 1M elements: a plain List walks
+    there with std::next, an order_statistic_index List asks for
+    iterator_at. Random inserts pair the jump with an insert there, and
+    push_back/pop_front shows what keeping the index current costs on
+    the operations that never need it.
+*/
+
+using Plain = List<size_t>;
+using Indexed = List<size_t, std::allocator<size_t>, pointers_first_layout, order_statistic_index>;
+
+constexpr size_t jumps = 1 << 10;
+constexpr size_t ops = 1 << 20;
+constexpr size_t runs = 3;
+
+// A cheap sequence of pseudo-random positions below bound
+struct Positions {
+    size_t state = 88172645463325252ULL;
+
+    size_t next(size_t bound) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state % bound;
+    }
+};
+
+size_t jump(Plain & ll, size_t pos) {
+    return *std::next(ll.begin(), pos);
+}
+size_t jump(Indexed & ll, size_t pos) {
+    return *ll.iterator_at(pos);
+}
+
+template<typename ListType>
+double jump_to_row(size_t elements) {
+    ListType ll;
+    for(size_t i = 0; i < elements; i++)
+        ll.push_back(i);
+
+    return best_of(runs, [&] {
+        Positions positions;
+        size_t sum = 0;
+        for(size_t i = 0; i < jumps; i++)
+            sum += jump(ll, positions.next(elements));
+        do_not_optimize(sum);
+    });
+}
+
+typename Plain::iterator locate(Plain & ll, size_t pos) {
+    return std::next(ll.begin(), pos);
+}
+typename Indexed::iterator locate(Indexed & ll, size_t pos) {
+    return ll.iterator_at(pos);
+}
+
+// Runs keep inserting into the same list, so later runs see it a little longer
+template<typename ListType>
+double insert_at_row(size_t elements) {
+    ListType ll;
+    for(size_t i = 0; i < elements; i++)
+        ll.push_back(i);
+
+    return best_of(runs, [&] {
+        Positions positions;
+        for(size_t i = 0; i < jumps; i++)
+            ll.insert(locate(ll, positions.next(ll.size() + 1)), i);
+        do_not_optimize(ll.size());
+    });
+}
+
+template<typename ListType>
+double push_pop() {
+    return best_of(runs, [&] {
+        ListType ll;
+        for(size_t i = 0; i < 1024; i++)
+            ll.push_back(i);
+
+        size_t sum = 0;
+        for(size_t i = 0; i < ops; i++) {
+            ll.push_back(i);
+            sum += ll.front();
+            ll.pop_front();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+int main() {
+    char name[64];
+
+    for(size_t elements : { 1 << 10, 1 << 16, 1 << 20 }) {
+        std::snprintf(name, sizeof(name), "std::next/n=%zu/jump", elements);
+        report(name, jumps, jump_to_row<Plain>(elements));
+        std::snprintf(name, sizeof(name), "iterator_at/n=%zu/jump", elements);
+        report(name, jumps, jump_to_row<Indexed>(elements));
+
+        std::snprintf(name, sizeof(name), "std::next/n=%zu/insert", elements);
+        report(name, jumps, insert_at_row<Plain>(elements));
+        std::snprintf(name, sizeof(name), "iterator_at/n=%zu/insert", elements);
+        report(name, jumps, insert_at_row<Indexed>(elements));
+    }
+
+    report("plain/push_pop", ops, push_pop<Plain>());
+    report("indexed/push_pop", ops, push_pop<Indexed>());
+}
@@ -0,0 +1,108 @@
+#include "bench.h"
+#include "Queue.h"
+#include "SpscQueue.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Producer/consumer throughput: one thread pushes ops integers
+    while another pops them, through a mutex-wrapped Queue<T> and
+    through SpscQueue, both element-wise and in bursts.
+*/
+
+constexpr size_t ops = 1 << 22;
+constexpr size_t runs = 5;
+constexpr size_t burst = 64;
+
+double locked_queue() {
+    return best_of(runs, [] {
+        Queue<size_t> q;
+        std::mutex lock;
+
+        std::thread producer([&] {
+            for(size_t i = 0; i < ops; i++) {
+                std::lock_guard<std::mutex> guard(lock);
+                q.push(i);
+            }
+        });
+
+        size_t sum = 0;
+        for(size_t popped = 0; popped < ops; ) {
+            std::lock_guard<std::mutex> guard(lock);
+            if(!q.empty()) {
+                sum += q.front();
+                q.pop();
+                popped++;
+            }
+        }
+
+        producer.join();
+        do_not_optimize(sum);
+    });
+}
+
+double spsc_queue() {
+    return best_of(runs, [] {
+        SpscQueue<size_t> q(1024);
+
+        std::thread producer([&] {
+            for(size_t i = 0; i < ops; i++)
+                q.push(i);
+        });
+
+        size_t sum = 0;
+        for(size_t popped = 0; popped < ops; ) {
+            if(!q.empty()) {
+                sum += q.front();
+                q.pop();
+                popped++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+        do_not_optimize(sum);
+    });
+}
+
+double spsc_queue_bulk() {
+    return best_of(runs, [] {
+        SpscQueue<size_t> q(1024);
+
+        std::thread producer([&] {
+            std::vector<size_t> values(burst);
+            for(size_t i = 0; i < ops; ) {
+                for(size_t j = 0; j < burst; j++)
+                    values[j] = i + j;
+
+                size_t pushed = q.push_n(values.begin(), burst < ops - i ? burst : ops - i);
+                if(pushed == 0)
+                    std::this_thread::yield();
+                i += pushed;
+            }
+        });
+
+        size_t sum = 0;
+        size_t values[burst];
+        for(size_t popped = 0; popped < ops; ) {
+            size_t count = q.pop_n(values, burst);
+            if(count == 0)
+                std::this_thread::yield();
+            for(size_t j = 0; j < count; j++)
+                sum += values[j];
+            popped += count;
+        }
+
+        producer.join();
+        do_not_optimize(sum);
+    });
+}
+
+int main() {
+    report("mutex + Queue<size_t>", ops, locked_queue());
+    report("SpscQueue<size_t> push/front/pop", ops, spsc_queue());
+    report("SpscQueue<size_t> push_n/pop_n", ops, spsc_queue_bulk());
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+/*
+    Walk a container forward and then backward alongside a
+    ground truth container (e.g. std::list) and report whether
+    every element, and both terminals, agree.
+*/
+template<typename ListType, typename GroundTruth>
+bool consistent(ListType const & ll, GroundTruth const & gt) {
+    if(ll.size() != gt.size())
+        return false;
+
+    auto it = ll.cbegin();
+    auto gt_it = gt.cbegin();
+
+    while(gt_it != gt.cend())
+        if(*gt_it++ != *it++)
+            return false;
+
+    if(it != ll.cend())
+        return false;
+
+    while(gt_it != gt.cbegin())
+        if(*--gt_it != *--it)
+            return false;
+
+    return it == ll.cbegin();
+}
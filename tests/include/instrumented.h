@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+    A value type which counts how it was created. Useful to
+    prove that a container constructs elements in place rather
+    than copying or moving a temporary into position.
+
+    Example:
+    {
+        Instrumented::reset();
+
+        List<Instrumented> ll;
+        ll.emplace_back(1, 2);
+
+        std::cout << Instrumented::copies << std::endl; // 0
+        std::cout << Instrumented::moves  << std::endl; // 0
+    }
+*/
+
+struct Instrumented {
+    static inline size_t constructions = 0;
+    static inline size_t copies = 0;
+    static inline size_t moves = 0;
+
+    int a;
+    int b;
+
+    Instrumented() : a { 0 }, b { 0 } { constructions++; }
+    Instrumented(int a, int b) : a { a }, b { b } { constructions++; }
+    Instrumented(Instrumented const & other) : a { other.a }, b { other.b } { copies++; }
+    Instrumented(Instrumented && other) noexcept : a { other.a }, b { other.b } { moves++; }
+    Instrumented & operator=(Instrumented const & other) { a = other.a; b = other.b; copies++; return *this; }
+    Instrumented & operator=(Instrumented && other) noexcept { a = other.a; b = other.b; moves++; return *this; }
+
+    bool operator==(Instrumented const & other) const { return a == other.a && b == other.b; }
+    bool operator!=(Instrumented const & other) const { return !(*this == other); }
+
+    static void reset() {
+        constructions = 0;
+        copies = 0;
+        moves = 0;
+    }
+};
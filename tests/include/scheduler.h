@@ -0,0 +1,83 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "Deque.h"
+#include "Queue.h"
+
+/*
+    A single-threaded round-robin scheduler for coroutine tests. A
+    Task starts suspended; spawn queues it, and run resumes ready
+    coroutines one at a time until none is left. A coroutine can
+    co_await yield() to go to the back of the line, and schedule
+    queues a handle woken by something else, such as AsyncQueue.
+
+    Each Task owns its frame and destroys it, finished or not, when
+    the Task goes out of scope.
+
+    Example:
+    {
+        Scheduler s;
+        Task task = [&]() -> Task { co_await s.yield(); }();
+
+        s.spawn(task);
+        s.run();
+
+        std::cout << task.done() << std::endl; // 1
+    }
+*/
+
+class Task {
+    public:
+
+    struct promise_type {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : _handle { handle } {}
+    Task(Task && other) noexcept : _handle { std::exchange(other._handle, nullptr) } {}
+    Task(Task const &) = delete;
+    Task & operator=(Task const &) = delete;
+    ~Task() { if(_handle) _handle.destroy(); }
+
+    std::coroutine_handle<> handle() const noexcept { return _handle; }
+    bool done() const noexcept { return _handle.done(); }
+
+    private:
+    std::coroutine_handle<promise_type> _handle;
+};
+
+class Scheduler {
+    Queue<std::coroutine_handle<>, Deque<std::coroutine_handle<>>> _ready;
+
+    public:
+
+    struct yield_awaiter {
+        Scheduler * scheduler;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { scheduler->_ready.push(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    void spawn(Task const & task) { _ready.push(task.handle()); }
+    void schedule(std::coroutine_handle<> handle) { _ready.push(handle); }
+
+    yield_awaiter yield() noexcept { return yield_awaiter { this }; }
+
+    // Resume ready coroutines until every one has finished or is
+    // suspended somewhere else
+    void run() {
+        while(!_ready.empty()) {
+            std::coroutine_handle<> handle = _ready.front();
+            _ready.pop();
+            handle.resume();
+        }
+    }
+};
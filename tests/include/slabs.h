@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+    Bulk constructors (count, fill, copy, range) carve their nodes
+    from slabs of up to ListType::slab_capacity nodes; a remainder of
+    fewer than ListType::min_slab_nodes is allocated node by node.
+    slabs_for returns the number of allocations needed for n nodes,
+    and slab_of which of them holds the j-th of n nodes.
+*/
+template<typename ListType>
+size_t slabs_for(size_t n) {
+    const size_t rest = n % ListType::slab_capacity;
+    return n / ListType::slab_capacity + (rest >= ListType::min_slab_nodes ? 1 : rest);
+}
+
+template<typename ListType>
+size_t slab_of(size_t j, size_t n) {
+    const size_t carved = n - (n % ListType::slab_capacity >= ListType::min_slab_nodes ? 0 : n % ListType::slab_capacity);
+    return j < carved ? j / ListType::slab_capacity : slabs_for<ListType>(carved) + (j - carved);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/*
+    A stateful allocator which counts the allocations and
+    deallocations it serves. Memory still comes from the
+    global operator new so Memhooks observe it as well.
+
+    Allocators compare equal when they share a counter.
+    The propagation traits are exposed as template flags
+    so tests can exercise each container code path.
+
+    Example:
+    {
+        AllocCounter counter;
+        List<int, TrackingAllocator<int>> ll { TrackingAllocator<int>(&counter) };
+
+        ll.push_back(1);
+
+        std::cout << counter.allocs << std::endl; // 1
+    }
+*/
+
+struct AllocCounter {
+    size_t allocs = 0;
+    size_t frees  = 0;
+};
+
+template<typename T, bool POCCA = false, bool POCMA = true, bool POCS = true>
+class TrackingAllocator {
+    template<typename, bool, bool, bool>
+    friend class TrackingAllocator;
+
+    AllocCounter * _counter;
+
+    public:
+
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::integral_constant<bool, POCCA>;
+    using propagate_on_container_move_assignment = std::integral_constant<bool, POCMA>;
+    using propagate_on_container_swap            = std::integral_constant<bool, POCS>;
+
+    template<typename U>
+    struct rebind { using other = TrackingAllocator<U, POCCA, POCMA, POCS>; };
+
+    explicit TrackingAllocator(AllocCounter * counter) noexcept : _counter { counter } {}
+
+    template<typename U>
+    TrackingAllocator(TrackingAllocator<U, POCCA, POCMA, POCS> const & other) noexcept
+    : _counter { other._counter } {}
+
+    T * allocate(size_t n) {
+        _counter->allocs++;
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T * ptr, size_t) noexcept {
+        _counter->frees++;
+        ::operator delete(ptr);
+    }
+
+    AllocCounter * counter() const noexcept { return _counter; }
+
+    template<typename U>
+    bool operator==(TrackingAllocator<U, POCCA, POCMA, POCS> const & other) const noexcept {
+        return _counter == other._counter;
+    }
+
+    template<typename U>
+    bool operator!=(TrackingAllocator<U, POCCA, POCMA, POCS> const & other) const noexcept {
+        return _counter != other._counter;
+    }
+};
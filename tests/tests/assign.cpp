@@ -0,0 +1,110 @@
+#include "executable.h"
+#include "consistency.h"
+#include "instrumented.h"
+#include "slabs.h"
+
+#include <list>
+#include <sstream>
+#include <vector>
+#include <iterator>
+
+TEST(assign) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        const size_t prev_n = t.range(0x999ULL);
+
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Pushed nodes are freed one at a time, so frees are exact
+        List<int> ll;
+        for(size_t j = 0; j < prev_n; j++)
+            ll.push_back(t.get<int>());
+
+        // Forward ranges reuse the overlap and slab-allocate the remainder
+        {
+            Memhook mh;
+            ll.assign(gt.begin(), gt.end());
+
+            ASSERT_EQ(n > prev_n ? slabs_for<List<int>>(n - prev_n) : 0ULL, mh.n_allocs());
+            ASSERT_EQ(n < prev_n ? prev_n - n : 0ULL, mh.n_frees());
+            ASSERT_EQ(true, consistent(ll, std::list<int>(gt.begin(), gt.end())));
+        }
+
+        // Assigning the same size again never touches the heap
+        {
+            std::list<int> gt_ll(n);
+            t.fill(gt_ll.begin(), gt_ll.end());
+            List<int> const other(gt_ll.begin(), gt_ll.end());
+
+            Memhook mh;
+            ll = other;
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+        }
+
+        // Count assignment follows the same budget
+        {
+            const size_t count = t.range(0x999ULL);
+            const int value = t.get<int>();
+
+            Memhook mh;
+            ll.assign(count, value);
+
+            ASSERT_EQ(count > n ? slabs_for<List<int>>(count - n) : 0ULL, mh.n_allocs());
+            ASSERT_EQ(true, consistent(ll, std::list<int>(count, value)));
+        }
+
+        // Input ranges allocate one node per appended element
+        {
+            std::stringstream ss;
+            for(size_t j = 0; j < n; j++)
+                ss << gt[j] << ' ';
+
+            List<int> in_ll;
+            for(size_t j = 0; j < prev_n; j++)
+                in_ll.push_back(0);
+
+            Memhook mh;
+            in_ll.assign(std::istream_iterator<int>(ss), std::istream_iterator<int>());
+
+            ASSERT_EQ(n > prev_n ? n - prev_n : 0ULL, mh.n_allocs());
+            ASSERT_EQ(n < prev_n ? prev_n - n : 0ULL, mh.n_frees());
+            ASSERT_EQ(true, consistent(in_ll, std::list<int>(gt.begin(), gt.end())));
+        }
+
+        // Overlapping elements are copy-assigned rather than reconstructed
+        {
+            List<Instrumented> src(n);
+            List<Instrumented> dst(prev_n);
+
+            Instrumented::reset();
+            dst = src;
+
+            ASSERT_EQ(n, Instrumented::copies);
+            ASSERT_EQ(0ULL, Instrumented::constructions);
+            ASSERT_EQ(n, dst.size());
+        }
+
+        // Range erase returns the position after the erased run
+        {
+            List<int> er(gt.begin(), gt.end());
+            std::list<int> gt_er(gt.begin(), gt.end());
+
+            const size_t from = t.range(n + 1);
+            const size_t to = from + t.range(n - from + 1);
+
+            auto first = std::next(er.begin(), from);
+            auto last = std::next(er.begin(), to);
+            auto it = er.erase(first, last);
+            gt_er.erase(std::next(gt_er.begin(), from), std::next(gt_er.begin(), to));
+
+            ASSERT_EQ(true, it == std::next(er.begin(), from));
+            ASSERT_EQ(true, consistent(er, gt_er));
+        }
+    }
+}
@@ -0,0 +1,225 @@
+#include "executable.h"
+#include "scheduler.h"
+#include "AsyncQueue.h"
+#include "box.h"
+
+#include <memory>
+#include <vector>
+
+// Pop count elements from q, appending them to out
+static Task consume(Scheduler & s, AsyncQueue<int> & q, std::vector<int> & out, size_t count) {
+    for(size_t j = 0; j < count; j++)
+        out.push_back(co_await q.pop(s));
+}
+
+// Pop count elements, pushing each one back to q for the next consumer
+static Task relay(Scheduler & s, AsyncQueue<int> & q, std::vector<int> & out, size_t count) {
+    for(size_t j = 0; j < count; j++) {
+        const int value = co_await q.pop(s);
+        out.push_back(value);
+        q.push(value);
+    }
+}
+
+// Takes the one handle it is given, for tests that resume it by hand
+struct Handoff {
+    std::coroutine_handle<> handle;
+
+    void schedule(std::coroutine_handle<> next) { handle = next; }
+};
+
+// Push values in random batches, yielding to the scheduler between them
+static Task produce(Scheduler & s, Typegen & t, AsyncQueue<int> & q, std::vector<int> const & values) {
+    for(size_t j = 0; j < values.size(); ) {
+        for(size_t batch = t.range(4ULL); batch > 0 && j < values.size(); batch--)
+            q.push(values[j++]);
+        co_await s.yield();
+    }
+}
+
+TEST(async_queue) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Each push wakes one waiting consumer, in the order they waited,
+        // without allocating; the consumers only run when the scheduler does
+        {
+            const size_t consumers = t.range(4ULL) + 1;
+            const size_t rounds = n / consumers;
+
+            Scheduler s;
+            AsyncQueue<int> q;
+            std::vector<std::vector<int>> received(consumers);
+            std::vector<Task> tasks;
+
+            for(size_t c = 0; c < consumers; c++) {
+                received[c].reserve(rounds);
+                tasks.push_back(consume(s, q, received[c], rounds));
+                s.spawn(tasks.back());
+            }
+            s.run();
+
+            ASSERT_EQ(rounds > 0 ? consumers : 0ULL, q.waiting());
+
+            for(size_t r = 0; r < rounds; r++) {
+                {
+                    Memhook mh;
+
+                    for(size_t c = 0; c < consumers; c++) {
+                        q.push(gt[r * consumers + c]);
+                        ASSERT_EQ(true, q.empty());
+                        ASSERT_EQ(consumers - c - 1, q.waiting());
+                    }
+
+                    ASSERT_EQ(0ULL, mh.n_allocs());
+                    ASSERT_EQ(0ULL, mh.n_frees());
+                }
+
+                ASSERT_EQ(r, received[0].size());
+                s.run();
+            }
+
+            ASSERT_EQ(0ULL, q.waiting());
+            for(size_t c = 0; c < consumers; c++) {
+                ASSERT_EQ(true, tasks[c].done());
+                for(size_t j = 0; j < rounds; j++)
+                    ASSERT_EQ(gt[j * consumers + c], received[c][j]);
+            }
+        }
+
+        // Elements pushed before anyone waits are queued and popped in order
+        // without suspending
+        {
+            Scheduler s;
+            AsyncQueue<int> q;
+            std::vector<int> received;
+
+            for(size_t j = 0; j < n; j++)
+                q.push(gt[j]);
+            ASSERT_EQ(n, q.size());
+
+            Task task = consume(s, q, received, n);
+            s.spawn(task);
+            s.run();
+
+            ASSERT_EQ(true, task.done());
+            ASSERT_EQ(true, q.empty());
+            ASSERT_EQ(true, received == gt);
+        }
+
+        // A producer and a consumer interleaved by the scheduler
+        {
+            Scheduler s;
+            AsyncQueue<int> q;
+            std::vector<int> received;
+
+            Task consumer = consume(s, q, received, n);
+            Task producer = produce(s, t, q, gt);
+            if(t.get<bool>()) {
+                s.spawn(consumer);
+                s.spawn(producer);
+            }
+            else {
+                s.spawn(producer);
+                s.spawn(consumer);
+            }
+            s.run();
+
+            ASSERT_EQ(true, consumer.done());
+            ASSERT_EQ(true, producer.done());
+            ASSERT_EQ(true, received == gt);
+            ASSERT_EQ(0ULL, q.waiting());
+        }
+
+        // Consumers that push from inside a wakeup hand off through the
+        // scheduler instead of resuming each other on the pusher's stack
+        {
+            const size_t relays = t.range(4ULL) + 2;
+            const size_t rounds = n / relays;
+
+            Scheduler s;
+            AsyncQueue<int> q;
+            std::vector<std::vector<int>> received(relays);
+            std::vector<Task> tasks;
+
+            for(size_t c = 0; c < relays; c++) {
+                tasks.push_back(relay(s, q, received[c], rounds));
+                s.spawn(tasks.back());
+            }
+            s.run();
+
+            if(rounds > 0) {
+                q.push(gt[0]);
+                ASSERT_EQ(true, received[0].empty());
+                s.run();
+            }
+
+            // The one value went round every relay, each in turn
+            for(size_t c = 0; c < relays; c++) {
+                ASSERT_EQ(true, tasks[c].done());
+                ASSERT_EQ(rounds, received[c].size());
+                for(int value : received[c])
+                    ASSERT_EQ(gt[0], value);
+            }
+            ASSERT_EQ(rounds > 0 ? 1ULL : 0ULL, q.size());
+        }
+
+        // Destroying a suspended consumer withdraws its wait
+        {
+            Scheduler s;
+            AsyncQueue<int> q;
+            std::vector<int> first, second;
+
+            std::unique_ptr<Task> abandoned(new Task(consume(s, q, first, 1)));
+            Task kept = consume(s, q, second, 1);
+            s.spawn(*abandoned);
+            s.spawn(kept);
+            s.run();
+            ASSERT_EQ(2ULL, q.waiting());
+
+            abandoned.reset();
+            ASSERT_EQ(1ULL, q.waiting());
+
+            q.push(1);
+            q.push(2);
+            s.run();
+            ASSERT_EQ(true, kept.done());
+            ASSERT_EQ(1, second.front());
+
+            int value = 0;
+            ASSERT_EQ(true, q.try_pop(value));
+            ASSERT_EQ(2, value);
+            ASSERT_EQ(false, q.try_pop(value));
+        }
+    }
+
+    // Elements are moved, not copied, to the waiting coroutine
+    {
+        AsyncQueue<Box<int>> q;
+        Handoff handoff;
+        Box<int> out(0);
+
+        Task task = [](AsyncQueue<Box<int>> & q, Handoff & handoff, Box<int> & out) -> Task {
+            out = co_await q.pop(handoff);
+        }(q, handoff, out);
+        task.handle().resume();
+
+        {
+            Memhook mh;
+            q.emplace(7);
+
+            // Only the payload of the new element was allocated
+            ASSERT_EQ(1ULL, mh.n_allocs());
+        }
+
+        ASSERT_EQ(false, task.done());
+        ASSERT_EQ(true, handoff.handle == task.handle());
+        handoff.handle.resume();
+        ASSERT_EQ(true, task.done());
+        ASSERT_EQ(7, *out);
+    }
+}
@@ -0,0 +1,171 @@
+#include "executable.h"
+#include "BlockingQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(blocking_queue) {
+    Typegen t;
+
+    using namespace std::chrono_literals;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        // Without contention it behaves like Queue
+        {
+            BlockingQueue<int> q;
+            std::list<int> gt;
+
+            for(size_t j = 0; j < n; j++) {
+                const int value = t.get<int>();
+
+                if(t.get<bool>(0.30) && !gt.empty()) {
+                    int popped = 0;
+                    ASSERT_EQ(true, q.try_pop_for(popped, 0ms));
+                    ASSERT_EQ(gt.front(), popped);
+                    gt.pop_front();
+                }
+
+                if(j % 2 == 0)
+                    ASSERT_EQ(true, q.push(value));
+                else
+                    ASSERT_EQ(true, q.emplace(value));
+                gt.push_back(value);
+
+                ASSERT_EQ(gt.size(), q.size());
+            }
+
+            // Batches drain in order and stop at max
+            std::vector<int> batch(0x40);
+            while(!gt.empty()) {
+                const size_t max = 1 + t.range(batch.size());
+                const size_t count = q.pop_batch(batch.begin(), max, 0ms);
+
+                ASSERT_EQ(std::min(max, gt.size()), count);
+                for(size_t j = 0; j < count; j++) {
+                    ASSERT_EQ(gt.front(), batch[j]);
+                    gt.pop_front();
+                }
+            }
+
+            ASSERT_EQ(true, q.empty());
+            ASSERT_EQ(0ULL, q.pop_batch(batch.begin(), batch.size(), 0ms));
+
+            // Closing refuses pushes but lets consumers drain what is left
+            q.push(1);
+            q.close();
+            ASSERT_EQ(true, q.is_closed());
+            ASSERT_EQ(false, q.push(2));
+
+            int popped = 0;
+            ASSERT_EQ(true, q.pop_wait(popped));
+            ASSERT_EQ(1, popped);
+            ASSERT_EQ(false, q.pop_wait(popped));
+            ASSERT_EQ(false, q.try_pop_for(popped, 1ms));
+        }
+    }
+
+    // Timed pops give up once the timeout has passed
+    {
+        BlockingQueue<int> q;
+        int popped = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_EQ(false, q.try_pop_for(popped, 20ms));
+        ASSERT_EQ(true, std::chrono::steady_clock::now() - start >= 20ms);
+
+        std::vector<int> batch(4);
+        start = std::chrono::steady_clock::now();
+        ASSERT_EQ(0ULL, q.pop_batch(batch.begin(), batch.size(), 20ms));
+        ASSERT_EQ(true, std::chrono::steady_clock::now() - start >= 20ms);
+    }
+
+    // Sleeping consumers are woken by pushes and by close
+    {
+        BlockingQueue<int> q;
+        std::atomic<int> received { -1 };
+
+        std::thread consumer([&] {
+            int value;
+            if(q.pop_wait(value))
+                received = value;
+        });
+        std::this_thread::sleep_for(5ms);
+        q.push(7);
+        consumer.join();
+        ASSERT_EQ(7, received.load());
+
+        std::atomic<bool> woke { false };
+        std::vector<std::thread> sleepers;
+        for(size_t j = 0; j < 4; j++) {
+            sleepers.emplace_back([&] {
+                int value;
+                std::vector<int> batch(8);
+                if(j % 2 == 0)
+                    woke = !q.pop_wait(value);
+                else
+                    woke = q.pop_batch(batch.begin(), batch.size(), 10s) == 0;
+            });
+        }
+        std::this_thread::sleep_for(5ms);
+        q.close();
+        for(std::thread & sleeper : sleepers)
+            sleeper.join();
+        ASSERT_EQ(true, woke.load());
+    }
+
+    // Producers and batch consumers: every element arrives exactly once,
+    // in push order per producer
+    const size_t producers = 4, consumers = 4;
+    const size_t per_producer = 0x3FFF;
+
+    for(size_t i = 0; i < 8; i++) {
+        BlockingQueue<std::pair<size_t, size_t>> q;
+        std::atomic<bool> in_order { true };
+        std::unique_ptr<std::atomic<unsigned char>[]> seen(
+            new std::atomic<unsigned char>[producers * per_producer]());
+
+        std::vector<std::thread> threads;
+        for(size_t p = 0; p < producers; p++) {
+            threads.emplace_back([&, p] {
+                for(size_t j = 0; j < per_producer; j++)
+                    q.emplace(p, j);
+            });
+        }
+        for(size_t c = 0; c < consumers; c++) {
+            threads.emplace_back([&, c] {
+                std::vector<long> last(producers, -1);
+                std::vector<std::pair<size_t, size_t>> batch(1 + c * 16);
+                size_t count;
+
+                while((count = q.pop_batch(batch.begin(), batch.size(), 1s)) > 0) {
+                    for(size_t j = 0; j < count; j++) {
+                        auto [producer, sequence] = batch[j];
+                        if(long(sequence) <= last[producer])
+                            in_order = false;
+                        last[producer] = long(sequence);
+                        seen[producer * per_producer + sequence]++;
+                    }
+                }
+            });
+        }
+
+        for(size_t p = 0; p < producers; p++)
+            threads[p].join();
+        q.close();
+        for(size_t c = 0; c < consumers; c++)
+            threads[producers + c].join();
+
+        ASSERT_EQ(true, in_order.load());
+
+        size_t delivered_once = 0;
+        for(size_t j = 0; j < producers * per_producer; j++)
+            delivered_once += seen[j].load() == 1;
+        ASSERT_EQ(producers * per_producer, delivered_once);
+    }
+}
@@ -1,4 +1,5 @@
 #include "executable.h"
+#include "slabs.h"
 #include "box.h"
 
 TEST(clear_and_empty) {
@@ -12,10 +13,10 @@ TEST(clear_and_empty) {
 
         List<int> * ll = new List<int>(sz, value);
 
-        // Each node should be allocated individually
+        // Nodes should be carved from slabs
         ASSERT_EQ(sz, ll->size());
         if(sz) {
-            ASSERT_EQ(sz + 1, mh.n_allocs());
+            ASSERT_EQ(slabs_for<List<int>>(sz) + 1, mh.n_allocs());
         }
 
         
@@ -0,0 +1,154 @@
+#include "executable.h"
+#include "ConcurrentQueue.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Counts live instances so leaks and double destruction show up
+struct Tracked {
+    static inline std::atomic<long> live { 0 };
+
+    size_t producer;
+    size_t sequence;
+
+    Tracked() : producer { 0 }, sequence { 0 } { live++; }
+    Tracked(size_t producer, size_t sequence) : producer { producer }, sequence { sequence } { live++; }
+    Tracked(Tracked const & other) : producer { other.producer }, sequence { other.sequence } { live++; }
+    Tracked & operator=(Tracked const & other) = default;
+    ~Tracked() { live--; }
+};
+
+TEST(concurrent_queue) {
+    Typegen t;
+
+    // Single-threaded, the queue behaves like any FIFO
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        {
+            ConcurrentQueue<int> q;
+            std::list<int> gt;
+
+            ASSERT_EQ(true, q.empty());
+
+            for(size_t j = 0; j < n; j++) {
+                const int value = t.get<int>();
+
+                if(t.get<bool>(0.30) && !gt.empty()) {
+                    int popped = 0;
+                    ASSERT_EQ(true, q.try_pop(popped));
+                    ASSERT_EQ(gt.front(), popped);
+                    gt.pop_front();
+                }
+
+                if(j % 2 == 0)
+                    q.push(value);
+                else
+                    q.emplace(value);
+                gt.push_back(value);
+            }
+
+            ASSERT_EQ(gt.empty(), q.empty());
+
+            int popped = 0;
+            while(!gt.empty()) {
+                ASSERT_EQ(true, q.try_pop(popped));
+                ASSERT_EQ(gt.front(), popped);
+                gt.pop_front();
+            }
+
+            ASSERT_EQ(false, q.try_pop(popped));
+            ASSERT_EQ(true, q.empty());
+        }
+
+        // Elements left in the queue are destroyed with it
+        {
+            {
+                ConcurrentQueue<Tracked> q;
+                for(size_t j = 0; j < n; j++)
+                    q.emplace(0, j);
+
+                Tracked popped;
+                for(size_t j = 0; j < n / 2; j++)
+                    q.try_pop(popped);
+            }
+            ASSERT_EQ(0L, Tracked::live.load());
+        }
+
+        // Retiring reuses the room a record reserved, so it never allocates
+        {
+            HazardDomain::Record & record = HazardDomain::local();
+            std::vector<int *> nodes(n);
+            for(size_t j = 0; j < n; j++)
+                nodes[j] = new int(static_cast<int>(j));
+
+            Memhook mh;
+            for(size_t j = 0; j < n; j++)
+                record.retire(nodes[j], [](void * ptr) { delete static_cast<int *>(ptr); });
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+    }
+
+    // Many producers and consumers: every element is delivered exactly once,
+    // and each consumer sees any one producer's elements in push order
+    const size_t producers = 4, consumers = 4;
+    const size_t per_producer = 0x3FFF;
+
+    for(size_t i = 0; i < 8; i++) {
+        {
+            ConcurrentQueue<Tracked> q;
+            std::atomic<size_t> consumed { 0 };
+            std::atomic<bool> in_order { true };
+
+            std::unique_ptr<std::atomic<unsigned char>[]> seen(
+                new std::atomic<unsigned char>[producers * per_producer]());
+
+            std::vector<std::thread> threads;
+
+            for(size_t p = 0; p < producers; p++) {
+                threads.emplace_back([&, p] {
+                    for(size_t j = 0; j < per_producer; j++) {
+                        if(j % 2 == 0)
+                            q.push(Tracked(p, j));
+                        else
+                            q.emplace(p, j);
+                    }
+                });
+            }
+
+            for(size_t c = 0; c < consumers; c++) {
+                threads.emplace_back([&] {
+                    std::vector<long> last(producers, -1);
+                    Tracked popped;
+
+                    while(consumed.load() < producers * per_producer) {
+                        if(!q.try_pop(popped))
+                            continue;
+
+                        if(long(popped.sequence) <= last[popped.producer])
+                            in_order = false;
+                        last[popped.producer] = long(popped.sequence);
+
+                        seen[popped.producer * per_producer + popped.sequence]++;
+                        consumed++;
+                    }
+                });
+            }
+
+            for(std::thread & thread : threads)
+                thread.join();
+
+            ASSERT_EQ(true, in_order.load());
+            ASSERT_EQ(true, q.empty());
+
+            size_t delivered_once = 0;
+            for(size_t j = 0; j < producers * per_producer; j++)
+                delivered_once += seen[j].load() == 1;
+            ASSERT_EQ(producers * per_producer, delivered_once);
+        }
+        ASSERT_EQ(0L, Tracked::live.load());
+    }
+}
@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <list>
 #include "executable.h"
+#include "slabs.h"
+#include "tracking_allocator.h"
 
 TEST(constructor_copy) {
     Typegen t;
@@ -24,7 +26,7 @@ TEST(constructor_copy) {
 
             ASSERT_EQ(gt_ll.size(), ll_cpy.size());
 
-            ASSERT_EQ(n, mh.n_allocs());
+            ASSERT_EQ(slabs_for<List<int>>(n), mh.n_allocs());
             ASSERT_EQ(0ULL, mh.n_frees());
 
             auto it = ll_cpy.cbegin();
@@ -37,6 +39,22 @@ TEST(constructor_copy) {
                 ASSERT_EQ(*--gt_it, *--it);
         }
 
+        // Copies select their allocator through allocator_traits, and
+        // slabs are served by it too
+        {
+            using Alloc = TrackingAllocator<int>;
+            AllocCounter counter;
+
+            const size_t n = t.range(0x999ULL);
+            List<int, Alloc> ll(n, 7, Alloc(&counter));
+            ASSERT_EQ((slabs_for<List<int, Alloc>>(n)), counter.allocs);
+
+            List<int, Alloc> ll_cpy = ll;
+            ASSERT_EQ(true, ll_cpy.get_allocator() == Alloc(&counter));
+            ASSERT_EQ((2 * slabs_for<List<int, Alloc>>(n)), counter.allocs);
+            ASSERT_EQ(n, ll_cpy.size());
+        }
+
         // No memory should be lost
         ASSERT_EQ(mh_mem_loss.n_frees(), mh_mem_loss.n_allocs());
     }
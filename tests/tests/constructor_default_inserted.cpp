@@ -1,4 +1,5 @@
 #include "executable.h"
+#include "slabs.h"
 #include "box.h"
 
 TEST(constructor_default_inserted) {
@@ -13,8 +14,8 @@ TEST(constructor_default_inserted) {
 
             List<int> * ll = new List<int>(sz);
 
-            // Each node should be allocated individually
-            ASSERT_EQ(sz + 1, mh.n_allocs());
+            // Nodes should be carved from slabs
+            ASSERT_EQ(slabs_for<List<int>>(sz) + 1, mh.n_allocs());
             ASSERT_EQ(sz, ll->size());
 
             // All elements should be zero initalized
@@ -30,7 +31,7 @@ TEST(constructor_default_inserted) {
             delete ll;
 
             // Let's not lose memory
-            ASSERT_EQ(sz + 1, mh.n_frees());
+            ASSERT_EQ(slabs_for<List<int>>(sz) + 1, mh.n_frees());
         }
 
         // A container which will allocate memory
@@ -49,7 +50,9 @@ TEST(constructor_default_inserted) {
             
             // Prevent additional, unneeded copies
             // Also ensure default constructor is called
-            ASSERT_EQ(2 * sz + 3, mh.n_allocs());
+            // The sentinels hold no payload, so only the
+            // list, its slabs and the payloads allocate
+            ASSERT_EQ(sz + slabs_for<List<Container>>(sz) + 1, mh.n_allocs());
 
             for(auto it = ll->cbegin(); it != ll->cend(); it++) {
                 ASSERT_EQ(4, *(*it).box);
@@ -58,7 +61,7 @@ TEST(constructor_default_inserted) {
             delete ll;
 
             // Ensure memory is freed
-            ASSERT_EQ(2 * sz + 3, mh.n_frees());
+            ASSERT_EQ(sz + slabs_for<List<Container>>(sz) + 1, mh.n_frees());
         }
     }
 }
@@ -1,4 +1,5 @@
 #include "executable.h"
+#include "slabs.h"
 #include "box.h"
 
 TEST(constructor_insert_copies) {
@@ -15,8 +16,8 @@ TEST(constructor_insert_copies) {
 
             List<int> * ll = new List<int>(sz, value);
 
-            // Each node should be allocated individually
-            ASSERT_EQ(sz + 1, mh.n_allocs());
+            // Nodes should be carved from slabs
+            ASSERT_EQ(slabs_for<List<int>>(sz) + 1, mh.n_allocs());
             ASSERT_EQ(sz, ll->size());
 
             // All elements should be zero initalized
@@ -32,7 +33,7 @@ TEST(constructor_insert_copies) {
             delete ll;
 
             // Let's not lose memory
-            ASSERT_EQ(sz + 1, mh.n_frees());
+            ASSERT_EQ(slabs_for<List<int>>(sz) + 1, mh.n_frees());
         }
 
         {
@@ -46,7 +47,7 @@ TEST(constructor_insert_copies) {
             
             // Prevent additional, unneeded copies
             // Also ensure constructor is called
-            ASSERT_EQ(2 * sz + 2, mh.n_allocs());
+            ASSERT_EQ(sz + slabs_for<List<Box<double>>>(sz) + 2, mh.n_allocs());
 
             for(auto it = ll->cbegin(); it != ll->cend(); it++) {
                 ASSERT_EQ(value, **it);
@@ -55,7 +56,7 @@ TEST(constructor_insert_copies) {
             delete ll;
 
             // Ensure memory is freed
-            ASSERT_EQ(2 * sz + 2, mh.n_frees());
+            ASSERT_EQ(sz + slabs_for<List<Box<double>>>(sz) + 2, mh.n_frees());
         }
     }
 }
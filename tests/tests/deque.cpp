@@ -0,0 +1,190 @@
+#include "executable.h"
+#include "consistency.h"
+#include "tracking_allocator.h"
+#include "Deque.h"
+#include "Queue.h"
+
+#include <deque>
+#include <vector>
+
+TEST(deque) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Blocks are filled before new ones are allocated
+        {
+            Memhook mh;
+
+            {
+                Deque<int, 8> dq;
+
+                for(size_t j = 0; j < n; j++)
+                    dq.push_back(gt[j]);
+
+                // One allocation per block; the rest belong to the map
+                size_t block_allocs = 0;
+                for(size_t j = 0; j < mh.n_blocks(); j++)
+                    if(mh[j].size == 8 * sizeof(int))
+                        block_allocs++;
+                ASSERT_EQ((n + 7) / 8, block_allocs);
+                ASSERT_EQ(n, dq.size());
+                ASSERT_EQ(true, consistent(dq, gt));
+
+                for(size_t j = 0; j < n; j++)
+                    ASSERT_EQ(gt[j], dq[j]);
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Random edits at both ends agree with std::deque
+        {
+            Memhook mh;
+
+            {
+                Deque<int, 4> dq;
+                std::deque<int> gt_dq;
+
+                for(size_t j = 0; j < n; j++) {
+                    const int value = gt[j];
+
+                    switch(t.range(4)) {
+                        case 0:
+                            dq.push_back(value);
+                            gt_dq.push_back(value);
+                            break;
+                        case 1:
+                            ASSERT_EQ(value, dq.emplace_front(value));
+                            gt_dq.push_front(value);
+                            break;
+                        case 2:
+                            if(!gt_dq.empty()) {
+                                dq.pop_front();
+                                gt_dq.pop_front();
+                            }
+                            break;
+                        default:
+                            if(!gt_dq.empty()) {
+                                dq.pop_back();
+                                gt_dq.pop_back();
+                            }
+                            break;
+                    }
+
+                    ASSERT_EQ(gt_dq.size(), dq.size());
+                    if(!gt_dq.empty()) {
+                        ASSERT_EQ(gt_dq.front(), dq.front());
+                        ASSERT_EQ(gt_dq.back(), dq.back());
+                    }
+                    ASSERT_EQ(true, (dq.spare_count() <= Deque<int, 4>::spare_blocks));
+                }
+
+                ASSERT_EQ(true, consistent(dq, gt_dq));
+
+                // Iterators are random access
+                if(!gt_dq.empty()) {
+                    const size_t offset = t.range(gt_dq.size());
+                    auto it = dq.begin() + offset;
+                    ASSERT_EQ(gt_dq[offset], *it);
+                    ASSERT_EQ(static_cast<ptrdiff_t>(offset), it - dq.begin());
+                    ASSERT_EQ(gt_dq.back(), dq.end()[-1]);
+                    ASSERT_EQ(true, dq.cbegin() < dq.cend());
+                }
+
+                // Copies and moves preserve the sequence
+                Deque<int, 4> cpy = dq;
+                ASSERT_EQ(true, consistent(cpy, gt_dq));
+
+                Deque<int, 4> moved = std::move(cpy);
+                ASSERT_EQ(true, consistent(moved, gt_dq));
+                ASSERT_EQ(0ULL, cpy.size());
+                ASSERT_EQ(true, cpy.begin() == cpy.end());
+
+                cpy = moved;
+                moved.clear();
+                ASSERT_EQ(true, moved.empty());
+                ASSERT_EQ(true, consistent(cpy, gt_dq));
+
+                swap(cpy, moved);
+                ASSERT_EQ(true, cpy.empty());
+                ASSERT_EQ(true, consistent(moved, gt_dq));
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // A steady-state FIFO recycles its blocks instead of allocating
+        {
+            Queue<int, Deque<int, 16>> q;
+            const size_t depth = t.range(100ULL) + 1;
+
+            // Warm up: one pass through the blocks a window of depth spans
+            for(size_t j = 0; j < depth; j++)
+                q.push(static_cast<int>(j));
+            for(size_t j = 0; j < depth + 32; j++) {
+                q.push(static_cast<int>(depth + j));
+                q.pop();
+            }
+
+            {
+                Memhook mh;
+
+                for(size_t j = 0; j < n; j++) {
+                    q.push(gt[j]);
+                    q.pop();
+                }
+
+                ASSERT_EQ(0ULL, mh.n_allocs());
+                ASSERT_EQ(0ULL, mh.n_frees());
+            }
+
+            ASSERT_EQ(depth, q.size());
+        }
+
+        // shrink_to_fit hands the spares back
+        {
+            AllocCounter counter;
+
+            {
+                Deque<int, 8, TrackingAllocator<int>> dq { TrackingAllocator<int>(&counter) };
+
+                for(size_t j = 0; j < n; j++)
+                    dq.push_back(gt[j]);
+                while(!dq.empty())
+                    dq.pop_front();
+
+                ASSERT_EQ(n > 8 ? 2ULL : n > 0 ? 1ULL : 0ULL, dq.spare_count());
+                dq.shrink_to_fit();
+                ASSERT_EQ(0ULL, dq.spare_count());
+                ASSERT_EQ(counter.allocs, counter.frees);
+            }
+
+            ASSERT_EQ(counter.allocs, counter.frees);
+        }
+
+        // Drop-in container for Queue
+        {
+            Queue<int, Deque<int>> q;
+            for(size_t j = 0; j < n; j++) {
+                q.push(gt[j]);
+                ASSERT_EQ(gt[j], q.back());
+            }
+
+            ASSERT_EQ(n, q.size());
+
+            Queue<int, Deque<int>> q_cpy = q;
+            ASSERT_EQ(true, q == q_cpy);
+
+            for(size_t j = 0; j < n; j++) {
+                ASSERT_EQ(gt[j], q.front());
+                q.pop();
+            }
+
+            ASSERT_EQ(true, q.empty());
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#include "executable.h"
+#include "instrumented.h"
+#include "Queue.h"
+
+#include <list>
+#include <vector>
+
+TEST(emplace) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(2 * n);
+        t.fill(gt.begin(), gt.end());
+
+        {
+            List<Instrumented> ll;
+            std::list<Instrumented> gt_ll;
+
+            Instrumented::reset();
+            Memhook mh;
+
+            for(size_t j = 0; j < n; j++) {
+                const int a = gt[2 * j], b = gt[2 * j + 1];
+
+                switch(j % 3) {
+                    case 0: {
+                        Instrumented & back = ll.emplace_back(a, b);
+                        ASSERT_EQ(&back, &ll.back());
+                        gt_ll.emplace_back(a, b);
+                        break;
+                    }
+                    case 1: {
+                        Instrumented & front = ll.emplace_front(a, b);
+                        ASSERT_EQ(&front, &ll.front());
+                        gt_ll.emplace_front(a, b);
+                        break;
+                    }
+                    default: {
+                        auto it = ll.emplace(++ll.cbegin(), a, b);
+                        ASSERT_EQ(a, it->a);
+                        ASSERT_EQ(b, it->b);
+                        gt_ll.emplace(++gt_ll.cbegin(), a, b);
+                        break;
+                    }
+                }
+            }
+
+            // One node per element and no temporaries
+            ASSERT_EQ(2 * n, mh.n_allocs());
+            ASSERT_EQ(2 * n, Instrumented::constructions);
+            ASSERT_EQ(0ULL, Instrumented::copies);
+            ASSERT_EQ(0ULL, Instrumented::moves);
+
+            ASSERT_EQ(gt_ll.size(), ll.size());
+
+            auto it = ll.cbegin();
+            auto gt_it = gt_ll.cbegin();
+
+            while(gt_it != gt_ll.cend())
+                ASSERT_EQ(true, *gt_it++ == *it++);
+
+            while(gt_it != gt_ll.cbegin())
+                ASSERT_EQ(true, *--gt_it == *--it);
+        }
+
+        // Default-inserted elements are value-initialized in place
+        {
+            Instrumented::reset();
+
+            List<Instrumented> ll(n);
+            ll.emplace_back();
+
+            ASSERT_EQ(n + 1, ll.size());
+            ASSERT_EQ(n + 1, Instrumented::constructions);
+            ASSERT_EQ(0ULL, Instrumented::copies);
+            ASSERT_EQ(0ULL, Instrumented::moves);
+        }
+
+        // Queue forwards emplace to its container
+        {
+            Queue<Instrumented> q;
+
+            Instrumented::reset();
+
+            for(size_t j = 0; j < n; j++) {
+                Instrumented & back = q.emplace(gt[2 * j], gt[2 * j + 1]);
+                ASSERT_EQ(&back, &q.back());
+            }
+
+            ASSERT_EQ(n, Instrumented::constructions);
+            ASSERT_EQ(0ULL, Instrumented::copies);
+            ASSERT_EQ(0ULL, Instrumented::moves);
+
+            for(size_t j = 0; j < n; j++) {
+                ASSERT_EQ(gt[2 * j], q.front().a);
+                ASSERT_EQ(gt[2 * j + 1], q.front().b);
+                q.pop();
+            }
+        }
+    }
+}
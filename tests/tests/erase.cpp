@@ -1,6 +1,9 @@
 #include <algorithm>
 #include <list>
+#include <vector>
 #include "executable.h"
+#include "slabs.h"
+#include "tracking_allocator.h"
 
 TEST(erase) {
     Typegen t;
@@ -20,21 +23,35 @@ TEST(erase) {
             auto gt_pos = gt_ll.begin();
             auto pos = ll.begin();
 
+            // Each node's slab, in list order, and the nodes left in every slab
+            std::list<size_t> slabs;
+            std::vector<size_t> live(slabs_for<List<int>>(n));
+            for(size_t j = 0; j < n; j++) {
+                slabs.push_back(slab_of<List<int>>(j, n));
+                live[slab_of<List<int>>(j, n)]++;
+            }
+            bool slab_walk_reversed = false;
+            auto slab_pos = slabs.begin();
+
             while(gt_ll.size() > 0) {
                 size_t steps = t.range(gt_ll.size() + 1);
                 
                 pos =  pace(ll, pos, steps, walk_reversed);
                 gt_pos = pace(gt_ll, gt_pos, steps, gt_walk_reversed);
+                slab_pos = pace(slabs, slab_pos, steps, slab_walk_reversed);
                 {
                     Memhook mh;
 
                     pos = ll.erase(pos);
 
-                    ASSERT_EQ(1ULL, mh.n_frees());
+                    // A slab is freed with its last node
+                    const bool slab_emptied = --live[*slab_pos] == 0;
+                    ASSERT_EQ(slab_emptied ? 1ULL : 0ULL, mh.n_frees());
                     ASSERT_EQ(0ULL, mh.n_allocs());
                 }
 
                 gt_pos = gt_ll.erase(gt_pos);
+                slab_pos = slabs.erase(slab_pos);
 
                 // Return value should point to the element following the erased item
                 if(gt_pos != gt_ll.end())
@@ -56,6 +73,22 @@ TEST(erase) {
             }
 
         }
+
+        // Erased nodes go back through the list's allocator
+        {
+            using Alloc = TrackingAllocator<int>;
+            AllocCounter counter;
+
+            List<int, Alloc> tracked { Alloc(&counter) };
+            for(size_t j = 0; j < n; j++)
+                tracked.push_back(static_cast<int>(j));
+
+            for(size_t j = 0; j < n; j++) {
+                tracked.erase(tracked.begin());
+                ASSERT_EQ(j + 1, counter.frees);
+            }
+            ASSERT_EQ(counter.allocs, counter.frees);
+        }
     }
     
 }
@@ -0,0 +1,77 @@
+#include "executable.h"
+#include "Executor.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Split [first, last) in halves down to single elements, summing the leaves
+static void sum_range(Executor & pool, std::atomic<size_t> & sum, size_t first, size_t last) {
+    if(last - first == 1) {
+        sum += first;
+        return;
+    }
+
+    const size_t middle = first + (last - first) / 2;
+    pool.submit([&pool, &sum, first, middle] { sum_range(pool, sum, first, middle); });
+    pool.submit([&pool, &sum, middle, last] { sum_range(pool, sum, middle, last); });
+}
+
+TEST(executor) {
+    Typegen t;
+
+    for(size_t i = 0; i < 8; i++) {
+        const size_t threads = t.range(4ULL) + 1;
+        const size_t n = t.range(0x3FFFULL) + 1;
+
+        Executor pool(threads);
+        ASSERT_EQ(threads, pool.size());
+
+        // Tasks submitted from outside each run exactly once
+        {
+            std::unique_ptr<std::atomic<unsigned char>[]> ran(new std::atomic<unsigned char>[n]());
+
+            for(size_t j = 0; j < n; j++)
+                pool.submit([&ran, j] { ran[j]++; });
+            pool.wait_idle();
+
+            size_t ran_once = 0;
+            for(size_t j = 0; j < n; j++)
+                ran_once += ran[j].load() == 1;
+            ASSERT_EQ(n, ran_once);
+        }
+
+        // wait_idle covers tasks submitted by other tasks
+        {
+            std::atomic<size_t> sum { 0 };
+            pool.submit([&pool, &sum, n] { sum_range(pool, sum, 0, n); });
+            pool.wait_idle();
+            ASSERT_EQ(n * (n - 1) / 2, sum.load());
+        }
+
+        // Several outside threads may submit at once; the destructor drains
+        // whatever is still queued
+        {
+            std::atomic<size_t> count { 0 };
+
+            {
+                Executor local(threads);
+                std::vector<std::thread> submitters;
+                for(size_t k = 0; k < 3; k++) {
+                    submitters.emplace_back([&] {
+                        for(size_t j = 0; j < n; j++)
+                            local.submit([&count] { count++; });
+                    });
+                }
+                for(std::thread & submitter : submitters)
+                    submitter.join();
+            }
+
+            ASSERT_EQ(3 * n, count.load());
+        }
+
+        // An idle pool waits without blocking
+        pool.wait_idle();
+    }
+}
@@ -0,0 +1,76 @@
+#include "executable.h"
+#include "PrefetchingIterator.h"
+
+#include <vector>
+
+// Collect the elements f sees, in the order it sees them
+template<size_t Distance, typename ListType>
+std::vector<int> visited(ListType & ll) {
+    std::vector<int> seen;
+    ll.template for_each<Distance>([&](auto & value) { seen.push_back(value); });
+    return seen;
+}
+
+TEST(for_each) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        List<int> ll;
+        for(size_t j = 0; j < n; j++) {
+            if(t.range(2))
+                ll.push_back(gt[j]);
+            else
+                ll.push_front(gt[j]);
+        }
+        const std::vector<int> order(ll.begin(), ll.end());
+
+        // Every distance, including none and one past the list, visits
+        // each element once in order
+        ASSERT_EQ(true, order == visited<0>(ll));
+        ASSERT_EQ(true, order == visited<1>(ll));
+        ASSERT_EQ(true, order == visited<default_prefetch_distance>(ll));
+        ASSERT_EQ(true, order == visited<0x1000>(ll));
+
+        List<int> const & cll = ll;
+        ASSERT_EQ(true, order == visited<default_prefetch_distance>(cll));
+
+        // f is returned with its state, and elements can be modified
+        {
+            struct Counter {
+                size_t calls = 0;
+                void operator()(int & value) { value++; calls++; }
+            };
+
+            Memhook mh;
+            Counter counter = ll.for_each(Counter());
+            ASSERT_EQ(n, counter.calls);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+        size_t j = 0;
+        for(int value : ll)
+            ASSERT_EQ(order[j++] + 1, value);
+
+        // The adaptor yields the same sequence as the iterator it wraps
+        {
+            using Iter = prefetching_iterator<List<int>::iterator>;
+            std::vector<int> seen;
+            for(Iter it(ll.begin(), ll.end()), last(ll.end(), ll.end()); it != last; it++)
+                seen.push_back(*it);
+            ASSERT_EQ(true, seen == std::vector<int>(ll.begin(), ll.end()));
+
+            using ShortIter = prefetching_iterator<List<int>::const_iterator, 1>;
+            ShortIter first(cll.begin(), cll.end()), last(cll.end(), cll.end());
+            ASSERT_EQ(true, std::vector<int>(first, last) == seen);
+
+            using PlainIter = prefetching_iterator<std::vector<int>::iterator, 0>;
+            PlainIter it(gt.begin(), gt.end());
+            for(size_t k = 0; k < n; k++, ++it)
+                ASSERT_EQ(gt[k], *it);
+            ASSERT_EQ(true, it.base() == gt.end());
+        }
+    }
+}
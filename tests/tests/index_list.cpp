@@ -0,0 +1,189 @@
+#include "executable.h"
+#include "consistency.h"
+#include "instrumented.h"
+#include "IndexList.h"
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+TEST(index_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // An empty list owns no storage
+        {
+            Memhook mh;
+            IndexList<int> ll;
+            ASSERT_EQ(0ULL, ll.capacity());
+            ASSERT_EQ(true, ll.begin() == ll.end());
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+
+        // Reserved lists fill with a single allocation, in one contiguous block
+        {
+            IndexList<int> ll;
+
+            Memhook mh;
+            ll.reserve(n);
+            for(size_t j = 0; j < n; j++)
+                ll.push_back(gt[j]);
+
+            ASSERT_EQ(n > 0 ? 1ULL : 0ULL, mh.n_allocs());
+            ASSERT_EQ(true, consistent(ll, std::list<int>(gt.begin(), gt.end())));
+
+            if(n > 0) {
+                char const * low = reinterpret_cast<char const *>(&ll.front());
+                char const * high = low;
+                for(auto it = ll.cbegin(); it != ll.cend(); it++) {
+                    char const * current = reinterpret_cast<char const *>(&(*it));
+                    low = std::min(low, current);
+                    high = std::max(high, current);
+                }
+                // A slot of int holds two 32-bit links and the value
+                ASSERT_EQ(true, size_t(high - low) < (ll.capacity() + 1) * 3 * sizeof(int));
+            }
+        }
+
+        // Random inserts and erases agree with std::list; erased slots are reused
+        {
+            IndexList<int> ll;
+            std::list<int> gt_ll;
+
+            auto pos = ll.begin();
+            auto gt_pos = gt_ll.begin();
+            bool reversed = false, gt_reversed = false;
+
+            for(size_t j = 0; j < n; j++) {
+                const size_t steps = t.range(gt_ll.size() + 1);
+                pos = pace(ll, pos, steps, reversed);
+                gt_pos = pace(gt_ll, gt_pos, steps, gt_reversed);
+
+                if(t.get<bool>(0.60) || gt_ll.empty()) {
+                    const int value = gt[j];
+                    pos = ll.insert(pos, value);
+                    gt_pos = gt_ll.insert(gt_pos, value);
+                    ASSERT_EQ(value, *pos);
+                } else {
+                    pos = ll.erase(pos);
+                    gt_pos = gt_ll.erase(gt_pos);
+                }
+
+                if(j % 64 == 0)
+                    ASSERT_EQ(true, consistent(ll, gt_ll));
+            }
+
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+
+            // Erase half, then refill: no allocation while slots are free
+            const size_t half = ll.size() / 2;
+            for(size_t j = 0; j < half; j++) {
+                if(j % 2 == 0) {
+                    ll.pop_front();
+                    gt_ll.pop_front();
+                } else {
+                    ll.pop_back();
+                    gt_ll.pop_back();
+                }
+            }
+
+            Memhook mh;
+            for(size_t j = 0; j < half; j++) {
+                ll.push_front(int(j));
+                gt_ll.push_front(int(j));
+            }
+            ASSERT_EQ(half, mh.n_allocs());  // std::list's nodes only
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+        }
+
+        // Iterators survive growth; elements that do not relocate trivially are moved
+        {
+            IndexList<std::string> ll;
+            std::list<std::string> gt_ll;
+
+            ll.push_back(std::string(40, 'x'));
+            gt_ll.push_back(std::string(40, 'x'));
+            auto first = ll.begin();
+
+            for(size_t j = 0; j < n; j++) {
+                std::string value = std::to_string(gt[j]);
+                if(j % 7 == 0)
+                    value.append(32, 'y');
+
+                ll.push_back(value);
+                gt_ll.push_back(value);
+            }
+
+            ASSERT_EQ(true, first == ll.begin());
+            ASSERT_EQ(true, std::string(40, 'x') == *first);
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+
+            // Arguments may alias an element while the array grows
+            for(size_t j = 0; j < 64; j++) {
+                ll.push_back(ll.front());
+                gt_ll.push_back(gt_ll.front());
+            }
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+        }
+
+        // Emplacement constructs in place
+        {
+            IndexList<Instrumented> ll;
+            ll.reserve(n);
+
+            Instrumented::reset();
+            for(size_t j = 0; j < n; j++) {
+                if(j % 2 == 0)
+                    ll.emplace_back(int(j), 1);
+                else
+                    ll.emplace_front(int(j), 2);
+            }
+
+            ASSERT_EQ(n, Instrumented::constructions);
+            ASSERT_EQ(0ULL, Instrumented::copies);
+            ASSERT_EQ(0ULL, Instrumented::moves);
+        }
+
+        // Copies, moves and swaps
+        {
+            IndexList<int> ll(gt.begin(), gt.end());
+            std::list<int> gt_ll(gt.begin(), gt.end());
+
+            IndexList<int> cpy = ll;
+            ASSERT_EQ(true, consistent(cpy, gt_ll));
+
+            IndexList<int> other { 1, 2, 3 };
+            other = ll;
+            ASSERT_EQ(true, consistent(other, gt_ll));
+
+            std::list<int> gt_small(3, 9);
+
+            Memhook mh;
+            IndexList<int> moved = std::move(cpy);
+            ASSERT_EQ(true, cpy.empty());
+            ASSERT_EQ(true, consistent(moved, gt_ll));
+
+            IndexList<int> small(3, 9);
+            swap(small, moved);
+            ASSERT_EQ(true, consistent(small, gt_ll));
+            ASSERT_EQ(true, consistent(moved, gt_small));
+
+            moved = std::move(small);
+            ASSERT_EQ(true, consistent(moved, gt_ll));
+
+            ll.clear();
+            ASSERT_EQ(true, ll.empty());
+            for(size_t j = 0; j < n; j++)
+                ll.push_back(gt[j]);
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+
+            // Only small's array was allocated; the cleared list reused its own
+            ASSERT_EQ(1ULL, mh.n_allocs());
+        }
+    }
+}
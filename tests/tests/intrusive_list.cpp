@@ -0,0 +1,212 @@
+#include "executable.h"
+#include "IntrusiveList.h"
+
+#include <algorithm>
+#include <vector>
+
+struct Item {
+    int value;
+    ListHook hook;
+    ListHook other_hook;
+};
+
+using ItemList = IntrusiveList<Item, &Item::hook>;
+
+// Walk forward and backward, checking the list threads exactly the expected
+// objects. The ground truth is a reserved vector so it never allocates
+// while a Memhook is watching the list
+template<typename ListType>
+bool threads(ListType const & ll, std::vector<Item *> const & gt) {
+    if(ll.size() != gt.size())
+        return false;
+
+    auto it = ll.cbegin();
+    auto gt_it = gt.cbegin();
+
+    while(gt_it != gt.cend())
+        if(*gt_it++ != &(*it++))
+            return false;
+
+    if(it != ll.cend())
+        return false;
+
+    while(gt_it != gt.cbegin())
+        if(*--gt_it != &(*--it))
+            return false;
+
+    return it == ll.cbegin();
+}
+
+TEST(intrusive_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        std::vector<Item> pool(n);
+        for(size_t j = 0; j < n; j++)
+            pool[j].value = t.get<int>();
+
+        // Linking and unlinking never touch the heap
+        {
+            std::vector<Item *> gt;
+            gt.reserve(n);
+
+            Memhook mh;
+            {
+                ItemList ll;
+
+                for(size_t j = 0; j < n; j++) {
+                    ASSERT_EQ(false, pool[j].hook.is_linked());
+
+                    if(t.get<bool>(0.50)) {
+                        ll.push_back(pool[j]);
+                        gt.push_back(&pool[j]);
+                    } else {
+                        ll.push_front(pool[j]);
+                        gt.insert(gt.begin(), &pool[j]);
+                    }
+
+                    ASSERT_EQ(true, pool[j].hook.is_linked());
+                }
+
+                ASSERT_EQ(0ULL, mh.n_allocs());
+                ASSERT_EQ(true, threads(ll, gt));
+                if(n > 0) {
+                    ASSERT_EQ(gt.front(), &ll.front());
+                    ASSERT_EQ(gt.back(), &ll.back());
+                }
+
+                // Erase by reference in O(1), in arbitrary order
+                for(size_t j = 0; j < n / 2; j++) {
+                    Item & victim = pool[t.range(n)];
+                    if(!victim.hook.is_linked())
+                        continue;
+
+                    auto next = ll.erase(victim);
+                    auto gt_it = gt.erase(std::find(gt.begin(), gt.end(), &victim));
+
+                    ASSERT_EQ(false, victim.hook.is_linked());
+                    ASSERT_EQ(true, (gt_it == gt.end()) == (next == ll.end()));
+                    if(gt_it != gt.end())
+                        ASSERT_EQ(*gt_it, &(*next));
+                }
+
+                ASSERT_EQ(true, threads(ll, gt));
+
+                // Iterators can be recovered from element references
+                for(auto gt_it = gt.begin(); gt_it != gt.end(); gt_it++)
+                    ASSERT_EQ(*gt_it, &(*ll.iterator_to(**gt_it)));
+
+                // Insert in front of arbitrary positions
+                for(size_t j = 0; j < n; j++) {
+                    if(pool[j].hook.is_linked())
+                        continue;
+
+                    const size_t steps = t.range(gt.size() + 1);
+                    auto pos = ll.begin();
+                    auto gt_pos = gt.begin();
+                    std::advance(pos, steps);
+                    std::advance(gt_pos, steps);
+
+                    auto it = ll.insert(pos, pool[j]);
+                    gt.insert(gt_pos, &pool[j]);
+                    ASSERT_EQ(&pool[j], &(*it));
+                }
+
+                ASSERT_EQ(true, threads(ll, gt));
+                ASSERT_EQ(n, ll.size());
+            }
+
+            // The destructor unlinks elements without freeing anything
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            for(size_t j = 0; j < n; j++)
+                ASSERT_EQ(false, pool[j].hook.is_linked());
+        }
+
+        // An element can sit on one list per hook
+        {
+            ItemList ll;
+            IntrusiveList<Item, &Item::other_hook> evens;
+            std::vector<Item *> gt, gt_evens;
+
+            for(size_t j = 0; j < n; j++) {
+                ll.push_back(pool[j]);
+                gt.push_back(&pool[j]);
+                if(pool[j].value % 2 == 0) {
+                    evens.push_back(pool[j]);
+                    gt_evens.push_back(&pool[j]);
+                }
+            }
+
+            ASSERT_EQ(true, threads(ll, gt));
+            ASSERT_EQ(true, threads(evens, gt_evens));
+
+            while(!evens.empty()) {
+                ll.erase(evens.front());
+                gt.erase(std::find(gt.begin(), gt.end(), gt_evens.front()));
+                evens.pop_front();
+                gt_evens.erase(gt_evens.begin());
+            }
+
+            ASSERT_EQ(true, threads(ll, gt));
+        }
+
+        // Moves, swaps and splices only relink sentinels
+        {
+            ItemList lhs, rhs;
+            std::vector<Item *> gt_lhs, gt_rhs;
+            gt_lhs.reserve(n);
+            gt_rhs.reserve(n);
+
+            for(size_t j = 0; j < n; j++) {
+                if(t.get<bool>(0.50)) {
+                    lhs.push_back(pool[j]);
+                    gt_lhs.push_back(&pool[j]);
+                } else {
+                    rhs.push_back(pool[j]);
+                    gt_rhs.push_back(&pool[j]);
+                }
+            }
+
+            Memhook mh;
+
+            swap(lhs, rhs);
+            std::swap(gt_lhs, gt_rhs);
+            ASSERT_EQ(true, threads(lhs, gt_lhs));
+            ASSERT_EQ(true, threads(rhs, gt_rhs));
+
+            ItemList moved = std::move(lhs);
+            ASSERT_EQ(true, lhs.empty());
+            ASSERT_EQ(true, lhs.size() == 0 && lhs.begin() == lhs.end());
+            ASSERT_EQ(true, threads(moved, gt_lhs));
+
+            if(!rhs.empty()) {
+                moved.splice(moved.begin(), rhs, --rhs.end());
+                gt_lhs.insert(gt_lhs.begin(), gt_rhs.back());
+                gt_rhs.pop_back();
+            }
+
+            moved.splice(moved.end(), rhs);
+            gt_lhs.insert(gt_lhs.end(), gt_rhs.begin(), gt_rhs.end());
+            gt_rhs.clear();
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            ASSERT_EQ(true, threads(moved, gt_lhs));
+            ASSERT_EQ(true, threads(rhs, gt_rhs));
+
+            if(n >= 2) {
+                moved.pop_back();
+                moved.pop_front();
+                gt_lhs.pop_back();
+                gt_lhs.erase(gt_lhs.begin());
+            }
+
+            lhs = std::move(moved);
+            ASSERT_EQ(true, threads(lhs, gt_lhs));
+            ASSERT_EQ(true, moved.empty());
+        }
+    }
+}
@@ -0,0 +1,213 @@
+#include "executable.h"
+#include "MpmcQueue.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Counts live instances and can be told to throw on construction or assignment
+struct Fragile {
+    static inline std::atomic<long> live { 0 };
+    static inline bool fail_assign = false;
+
+    size_t producer;
+    size_t sequence;
+
+    Fragile() : producer { 0 }, sequence { 0 } { live++; }
+    Fragile(size_t producer, size_t sequence, bool fail = false) : producer { producer }, sequence { sequence } {
+        if(fail)
+            throw std::runtime_error("construction failed");
+        live++;
+    }
+    Fragile(Fragile const & other) : producer { other.producer }, sequence { other.sequence } { live++; }
+    Fragile & operator=(Fragile const & other) {
+        if(fail_assign)
+            throw std::runtime_error("assignment failed");
+        producer = other.producer;
+        sequence = other.sequence;
+        return *this;
+    }
+    ~Fragile() { live--; }
+};
+
+TEST(mpmc_queue) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        const size_t requested = 1 + t.range(0xFFULL);
+
+        // Single-threaded it is a bounded FIFO that never allocates after construction
+        {
+            MpmcQueue<int> q(requested);
+            std::list<int> gt;
+
+            const size_t capacity = q.capacity();
+            ASSERT_EQ(0ULL, capacity & (capacity - 1));
+            ASSERT_EQ(true, capacity >= requested);
+
+            Memhook mh;
+
+            for(size_t j = 0; j < n; j++) {
+                const int value = t.get<int>();
+
+                if(t.get<bool>(0.45) && !gt.empty()) {
+                    int popped = 0;
+                    ASSERT_EQ(true, q.try_pop(popped));
+                    ASSERT_EQ(gt.front(), popped);
+                    gt.pop_front();
+                } else if(gt.size() == capacity) {
+                    ASSERT_EQ(false, q.try_push(value));
+                } else {
+                    ASSERT_EQ(true, q.try_push(value));
+                    gt.push_back(value);
+                }
+
+                ASSERT_EQ(gt.size(), q.size());
+                ASSERT_EQ(gt.empty(), q.empty());
+            }
+
+            int popped = 0;
+            while(!gt.empty()) {
+                ASSERT_EQ(true, q.try_pop(popped));
+                ASSERT_EQ(gt.front(), popped);
+                gt.pop_front();
+            }
+            ASSERT_EQ(false, q.try_pop(popped));
+
+            // Only the ground truth's nodes were allocated
+            ASSERT_EQ(mh.n_frees(), mh.n_allocs());
+        }
+
+        // A throwing constructor leaves a hole consumers skip over
+        {
+            {
+                MpmcQueue<Fragile> q(requested);
+                std::list<size_t> gt;
+                size_t holes = 0;
+
+                // Holes occupy a cell until a consumer skips them
+                for(size_t j = 0; j < n && gt.size() + holes < q.capacity(); j++) {
+                    const bool fail = t.get<bool>(0.20);
+                    if(fail) {
+                        bool threw = false;
+                        try {
+                            q.try_emplace(0, j, true);
+                        } catch(std::runtime_error const &) {
+                            threw = true;
+                        }
+                        ASSERT_EQ(true, threw);
+                        holes++;
+                    } else {
+                        ASSERT_EQ(true, q.try_emplace(0, j));
+                        gt.push_back(j);
+                    }
+                }
+
+                Fragile popped;
+                for(size_t j = 0; j < gt.size() / 2; j++) {
+                    ASSERT_EQ(true, q.try_pop(popped));
+                    ASSERT_EQ(gt.front(), popped.sequence);
+                    gt.pop_front();
+                }
+            }
+            ASSERT_EQ(0L, Fragile::live.load());
+        }
+
+        // A throwing assignment in try_pop drops that element but releases
+        // its cell, so producers can still lap the ring
+        {
+            {
+                MpmcQueue<Fragile> q(requested);
+                Fragile popped;
+
+                ASSERT_EQ(true, q.try_emplace(0, 0));
+                Fragile::fail_assign = true;
+                bool threw = false;
+                try {
+                    q.try_pop(popped);
+                } catch(std::runtime_error const &) {
+                    threw = true;
+                }
+                Fragile::fail_assign = false;
+                ASSERT_EQ(true, threw);
+                ASSERT_EQ(true, q.empty());
+
+                for(size_t lap = 0; lap < 2; lap++) {
+                    for(size_t j = 0; j < q.capacity(); j++)
+                        ASSERT_EQ(true, q.try_emplace(0, j));
+                    for(size_t j = 0; j < q.capacity(); j++) {
+                        ASSERT_EQ(true, q.try_pop(popped));
+                        ASSERT_EQ(j, popped.sequence);
+                    }
+                }
+            }
+            ASSERT_EQ(0L, Fragile::live.load());
+        }
+    }
+
+    // Many producers and consumers: every element is delivered exactly once,
+    // and each consumer sees any one producer's elements in push order
+    const size_t producers = 4, consumers = 4;
+    const size_t per_producer = 0x3FFF;
+
+    for(size_t i = 0; i < 8; i++) {
+        {
+            MpmcQueue<Fragile> q(1 + t.range(0x3FFULL));
+            std::atomic<size_t> consumed { 0 };
+            std::atomic<bool> in_order { true };
+
+            std::unique_ptr<std::atomic<unsigned char>[]> seen(
+                new std::atomic<unsigned char>[producers * per_producer]());
+
+            std::vector<std::thread> threads;
+
+            for(size_t p = 0; p < producers; p++) {
+                threads.emplace_back([&, p] {
+                    for(size_t j = 0; j < per_producer; j++) {
+                        if(j % 2 == 0)
+                            q.push(Fragile(p, j));
+                        else
+                            q.emplace(p, j);
+                    }
+                });
+            }
+
+            for(size_t c = 0; c < consumers; c++) {
+                threads.emplace_back([&] {
+                    std::vector<long> last(producers, -1);
+                    Fragile popped;
+
+                    while(consumed.load() < producers * per_producer) {
+                        if(!q.try_pop(popped)) {
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        if(long(popped.sequence) <= last[popped.producer])
+                            in_order = false;
+                        last[popped.producer] = long(popped.sequence);
+
+                        seen[popped.producer * per_producer + popped.sequence]++;
+                        consumed++;
+                    }
+                });
+            }
+
+            for(std::thread & thread : threads)
+                thread.join();
+
+            ASSERT_EQ(true, in_order.load());
+            ASSERT_EQ(true, q.empty());
+
+            size_t delivered_once = 0;
+            for(size_t j = 0; j < producers * per_producer; j++)
+                delivered_once += seen[j].load() == 1;
+            ASSERT_EQ(producers * per_producer, delivered_once);
+        }
+        ASSERT_EQ(0L, Fragile::live.load());
+    }
+}
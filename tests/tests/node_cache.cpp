@@ -0,0 +1,118 @@
+#include "executable.h"
+#include "box.h"
+
+#include <vector>
+
+TEST(node_cache) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(1ULL, 0x3FFULL);
+        const size_t limit = t.range(n);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Recycling is disabled by default
+        {
+            List<int> ll;
+            ASSERT_EQ(0ULL, ll.node_cache_limit());
+
+            ll.push_back(gt[0]);
+
+            Memhook mh;
+            ll.pop_back();
+            ASSERT_EQ(1ULL, mh.n_frees());
+            ASSERT_EQ(0ULL, ll.cached_nodes());
+        }
+
+        {
+            Memhook mh_mem_loss;
+
+            {
+                List<Box<int>> ll;
+                ll.set_node_cache_limit(limit);
+
+                for(size_t j = 0; j < n; j++)
+                    ll.push_back(gt[j]);
+
+                // Only the payloads are freed past the high-water mark
+                {
+                    Memhook mh;
+
+                    for(size_t j = 0; j < n; j++)
+                        ll.pop_front();
+
+                    ASSERT_EQ(limit, ll.cached_nodes());
+                    ASSERT_EQ(n + (n - limit), mh.n_frees());
+                }
+
+                // Cached nodes are reused before the allocator is asked
+                {
+                    std::vector<Box<int>> boxes(n);
+                    for(size_t j = 0; j < n; j++)
+                        boxes[j] = gt[j];
+
+                    Memhook mh;
+
+                    for(size_t j = 0; j < n; j++)
+                        ll.push_back(std::move(boxes[j]));
+
+                    ASSERT_EQ(n - limit, mh.n_allocs());
+                    ASSERT_EQ(0ULL, ll.cached_nodes());
+                    ASSERT_EQ(n, ll.size());
+
+                    size_t j = 0;
+                    for(auto it = ll.cbegin(); it != ll.cend(); it++)
+                        ASSERT_EQ(gt[j++], **it);
+                }
+
+                // clear() also feeds the cache
+                ll.clear();
+                ASSERT_EQ(limit, ll.cached_nodes());
+
+                // Lowering the limit trims the cache
+                {
+                    Memhook mh;
+                    ll.set_node_cache_limit(limit / 2);
+                    ASSERT_EQ(limit / 2, ll.cached_nodes());
+                    ASSERT_EQ(limit - limit / 2, mh.n_frees());
+                }
+
+                // shrink_to_fit() releases everything
+                {
+                    Memhook mh;
+                    ll.shrink_to_fit();
+                    ASSERT_EQ(0ULL, ll.cached_nodes());
+                    ASSERT_EQ(limit / 2, mh.n_frees());
+                    ASSERT_EQ(limit / 2, ll.node_cache_limit());
+                }
+
+                for(size_t j = 0; j < n; j++)
+                    ll.push_front(gt[j]);
+                for(size_t j = 0; j < n / 2; j++)
+                    ll.erase(ll.begin());
+            }
+
+            // Destroying a list releases its cached nodes
+            ASSERT_EQ(mh_mem_loss.n_allocs(), mh_mem_loss.n_frees());
+        }
+
+        // The cache moves along with the nodes
+        {
+            List<int> ll;
+            ll.set_node_cache_limit(n);
+            for(size_t j = 0; j < n; j++)
+                ll.push_back(gt[j]);
+            ll.pop_back();
+
+            List<int> moved = std::move(ll);
+            ASSERT_EQ(1ULL, moved.cached_nodes());
+            ASSERT_EQ(n, moved.node_cache_limit());
+            ASSERT_EQ(0ULL, ll.cached_nodes());
+
+            Memhook mh;
+            moved.push_back(gt[0]);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+    }
+}
@@ -0,0 +1,196 @@
+#include "executable.h"
+#include "consistency.h"
+#include "NodeCacheAllocator.h"
+#include "BlockingQueue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <thread>
+#include <vector>
+
+using CachedList = List<int, NodeCacheAllocator<int>>;
+
+// Records how to reach the pool the list's rebound node allocator uses,
+// since List's node type is private
+template<typename T>
+struct PoolProbe : NodeCacheAllocator<T> {
+    static inline size_t (*fresh_blocks)() = nullptr;
+    static inline size_t (*depot_size)() = nullptr;
+    static inline void (*trim)() = nullptr;
+
+    PoolProbe() noexcept = default;
+    template<typename U>
+    PoolProbe(PoolProbe<U> const &) noexcept {}
+
+    T * allocate(size_t count) {
+        using Pool = typename NodeCacheAllocator<T>::pool_type;
+        if(count == 1) {
+            PoolProbe<int>::fresh_blocks = [] { return Pool::instance().fresh_blocks(); };
+            PoolProbe<int>::depot_size = [] { return Pool::instance().depot_size(); };
+            PoolProbe<int>::trim = [] { Pool::instance().trim(); };
+        }
+        return NodeCacheAllocator<T>::allocate(count);
+    }
+};
+
+using ProbedList = List<int, PoolProbe<int>>;
+
+TEST(node_cache_allocator) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Once this thread's magazines and the depot hold enough blocks, a
+        // list can be refilled and drained without touching operator new
+        {
+            CachedList ll;
+            for(size_t j = 0; j < n; j++)
+                ll.push_back(gt[j]);
+            ll.clear();
+
+            {
+                Memhook mh;
+
+                for(size_t j = 0; j < n; j++)
+                    ll.push_back(gt[j]);
+                ASSERT_EQ(true, consistent(ll, gt));
+
+                for(size_t j = 0; j < n; j++)
+                    ll.pop_front();
+
+                ASSERT_EQ(0ULL, mh.n_allocs());
+                ASSERT_EQ(0ULL, mh.n_frees());
+            }
+        }
+
+        // Random edits behave as with the default allocator
+        {
+            CachedList ll;
+            std::list<int> gt_ll;
+
+            for(size_t j = 0; j < n; j++) {
+                switch(t.range(4)) {
+                    case 0:
+                        ll.push_front(gt[j]);
+                        gt_ll.push_front(gt[j]);
+                        break;
+                    case 1:
+                        if(!gt_ll.empty()) {
+                            ll.pop_back();
+                            gt_ll.pop_back();
+                        }
+                        break;
+                    default:
+                        ll.push_back(gt[j]);
+                        gt_ll.push_back(gt[j]);
+                        break;
+                }
+            }
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+
+            // Bulk slabs bypass the pool and are freed normally
+            CachedList cpy = ll;
+            ASSERT_EQ(true, consistent(cpy, gt_ll));
+        }
+
+        // Over-aligned nodes, pooled or in slabs, keep their alignment
+        {
+            List<int, NodeCacheAllocator<int>, cache_line_layout> ll(gt.begin(), gt.end());
+            for(size_t j = 0; j < n; j++) {
+                ll.push_back(gt[j]);
+                ll.push_front(gt[j]);
+            }
+
+            const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(&ll.front()) % 64;
+            for(int const & value : ll)
+                ASSERT_EQ(offset, reinterpret_cast<std::uintptr_t>(&value) % 64);
+            ASSERT_EQ(3 * n, ll.size());
+        }
+    }
+
+    // Blocks freed on another thread go back to the thread that allocated
+    // them, which reuses them before it asks the depot
+    {
+        using Pool = NodePool<48, 16>;
+        Pool & pool = Pool::instance();
+        const size_t count = 4 * Pool::magazine_size;
+
+        std::vector<void *> blocks(count);
+        for(void *& block : blocks)
+            block = pool.allocate();
+        const size_t fresh = pool.fresh_blocks();
+
+        std::thread([&] {
+            for(void * block : blocks)
+                pool.deallocate(block);
+        }).join();
+        ASSERT_EQ(0ULL, pool.depot_size());
+
+        std::vector<void *> again(count);
+        for(void *& block : again)
+            block = pool.allocate();
+        ASSERT_EQ(fresh, pool.fresh_blocks());
+
+        std::sort(blocks.begin(), blocks.end());
+        std::sort(again.begin(), again.end());
+        ASSERT_EQ(true, blocks == again);
+
+        // Blocks of a thread that has exited go to the depot instead
+        std::vector<void *> orphans(count);
+        std::thread([&] {
+            for(void *& block : orphans)
+                block = pool.allocate();
+        }).join();
+        for(void * block : orphans)
+            pool.deallocate(block);
+        ASSERT_EQ(count / Pool::magazine_size, pool.depot_size());
+
+        for(void * block : again)
+            pool.deallocate(block);
+        pool.trim();
+        ASSERT_EQ(0ULL, pool.depot_size());
+    }
+
+    // A producer allocates the nodes a consumer frees. The consumer sends
+    // full magazines back to the producer, or to the depot once it has
+    // exited, so once the pool holds a round's worth of nodes no round
+    // calls operator new
+    const size_t per_round = 0x3FFF;
+    {
+        ProbedList warm;
+        for(size_t j = 0; j < per_round + 4 * NodeCacheAllocator<int>::pool_type::magazine_size; j++)
+            warm.push_back(0);
+    }
+    const size_t fresh_before = PoolProbe<int>::fresh_blocks();
+
+    for(size_t round = 0; round < 8; round++) {
+        BlockingQueue<int, ProbedList> q;
+        long sum = 0;
+
+        std::thread consumer([&] {
+            int value;
+            while(q.pop_wait(value))
+                sum += value;
+        });
+        std::thread producer([&] {
+            for(size_t j = 0; j < per_round; j++)
+                q.push(static_cast<int>(j));
+            q.close();
+        });
+
+        producer.join();
+        consumer.join();
+
+        ASSERT_EQ(long(per_round) * long(per_round - 1) / 2, sum);
+        ASSERT_EQ(fresh_before, PoolProbe<int>::fresh_blocks());
+    }
+
+    // Exited threads flushed their magazines to the depot; trim frees them
+    ASSERT_EQ(true, PoolProbe<int>::depot_size() > 0);
+    PoolProbe<int>::trim();
+    ASSERT_EQ(0ULL, PoolProbe<int>::depot_size());
+}
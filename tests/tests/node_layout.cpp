@@ -0,0 +1,145 @@
+#include "executable.h"
+#include "consistency.h"
+#include "slabs.h"
+#include "box.h"
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+// A payload larger than the links, to exercise every layout's padding
+struct Wide {
+    int value;
+    char pad[44];
+
+    Wide(int value = 0) : value { value }, pad {} {}
+    bool operator!=(Wide const & other) const { return value != other.value; }
+};
+
+// Three 16 bit channels: 2 byte aligned, so it packs in behind the slab index
+struct Rgb {
+    uint16_t r, g, b;
+
+    Rgb(int value = 0) : r { static_cast<uint16_t>(value) }, g {}, b {} {}
+    bool operator!=(Rgb const & other) const { return r != other.r; }
+};
+
+// Mixed single and bulk edits against std::list, with node recycling on
+// so freed slab nodes are reused; every node must be freed at the end
+template<typename T, typename Layout>
+bool exercise(Typegen & t, std::vector<int> const & gt) {
+    using ListType = List<T, std::allocator<T>, Layout>;
+    const size_t n = gt.size();
+
+    Memhook mh;
+    {
+        ListType ll(gt.begin(), gt.end());
+        std::list<T> gt_ll(gt.begin(), gt.end());
+        ll.set_node_cache_limit(t.range(32ULL));
+
+        for(size_t j = 0; j < n; j++) {
+            switch(t.range(5)) {
+                case 0:
+                    ll.push_front(T(gt[j]));
+                    gt_ll.push_front(T(gt[j]));
+                    break;
+                case 1:
+                    if(!gt_ll.empty()) {
+                        ll.pop_front();
+                        gt_ll.pop_front();
+                    }
+                    break;
+                case 2:
+                    if(!gt_ll.empty()) {
+                        ll.pop_back();
+                        gt_ll.pop_back();
+                    }
+                    break;
+                default:
+                    ll.push_back(T(gt[j]));
+                    gt_ll.push_back(T(gt[j]));
+                    break;
+            }
+        }
+        if(!consistent(ll, gt_ll))
+            return false;
+
+        ListType cpy = ll;
+        if(!consistent(cpy, gt_ll))
+            return false;
+
+        ListType spliced;
+        spliced.splice(spliced.end(), cpy);
+        if(!consistent(spliced, gt_ll) || !cpy.empty())
+            return false;
+    }
+    return mh.n_allocs() == mh.n_frees();
+}
+
+// Every element sits at the same offset into a cache line, so each
+// 64 byte node starts a line of its own
+template<typename ListType>
+bool line_aligned(ListType const & ll) {
+    if(ll.empty())
+        return true;
+
+    const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(&ll.front()) % 64;
+    for(auto const & value : ll)
+        if(reinterpret_cast<std::uintptr_t>(&value) % 64 != offset)
+            return false;
+    return true;
+}
+
+TEST(node_layout) {
+    Typegen t;
+
+    // Slab indexes fill padding: no layout pays for a slab pointer
+    if(sizeof(void *) == 8) {
+        ASSERT_EQ(24ULL, List<int>::node_size);
+        ASSERT_EQ(24ULL, (List<int, std::allocator<int>, pointers_first_layout>::node_size));
+        ASSERT_EQ(24ULL, (List<int, std::allocator<int>, data_first_layout>::node_size));
+        ASSERT_EQ(32ULL, (List<double, std::allocator<double>, pointers_first_layout>::node_size));
+
+        // ... and the 16 bit index leaves room for 2 byte aligned elements too
+        ASSERT_EQ(24ULL, (List<Rgb, std::allocator<Rgb>, pointers_first_layout>::node_size));
+        ASSERT_EQ(24ULL, (List<Rgb, std::allocator<Rgb>, data_first_layout>::node_size));
+    }
+    ASSERT_EQ(64ULL, (List<int, std::allocator<int>, cache_line_layout>::node_size));
+    ASSERT_EQ(128ULL, (List<Wide, std::allocator<Wide>, cache_line_layout>::node_size));
+    ASSERT_EQ(true, (std::is_same<pointers_first_layout, List<int>::layout_type>::value));
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x1FFULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        ASSERT_EQ(true, (exercise<int, pointers_first_layout>(t, gt)));
+        ASSERT_EQ(true, (exercise<int, data_first_layout>(t, gt)));
+        ASSERT_EQ(true, (exercise<int, cache_line_layout>(t, gt)));
+
+        ASSERT_EQ(true, (exercise<char, pointers_first_layout>(t, gt)));
+        ASSERT_EQ(true, (exercise<Wide, data_first_layout>(t, gt)));
+        ASSERT_EQ(true, (exercise<Rgb, pointers_first_layout>(t, gt)));
+        ASSERT_EQ(true, (exercise<Rgb, data_first_layout>(t, gt)));
+
+        exercise<Box<int>, data_first_layout>(t, gt);
+        exercise<Box<int>, cache_line_layout>(t, gt);
+
+        // Bulk slabs work for every layout
+        {
+            Memhook mh;
+            List<int, std::allocator<int>, data_first_layout> data_first(gt.begin(), gt.end());
+            ASSERT_EQ((slabs_for<List<int, std::allocator<int>, data_first_layout>>(n)), mh.n_allocs());
+            ASSERT_EQ(true, consistent(data_first, gt));
+        }
+        {
+            List<int, std::allocator<int>, cache_line_layout> aligned(gt.begin(), gt.end());
+            ASSERT_EQ(true, consistent(aligned, gt));
+            ASSERT_EQ(true, line_aligned(aligned));
+
+            aligned.push_front(1);
+            aligned.push_back(2);
+            ASSERT_EQ(true, line_aligned(aligned));
+        }
+    }
+}
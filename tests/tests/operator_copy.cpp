@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <list>
 #include "executable.h"
+#include "slabs.h"
+#include "tracking_allocator.h"
 
 TEST(operator_copy) {
 
@@ -25,8 +27,9 @@ TEST(operator_copy) {
             Memhook mh;
             ll_cpy = const_ll;
 
-            ASSERT_EQ(n, mh.n_allocs());
-            ASSERT_EQ(prev_n, mh.n_frees());
+            // Existing nodes are reused, only the size difference touches the heap
+            ASSERT_EQ(n > prev_n ? slabs_for<List<int>>(n - prev_n) : 0ULL, mh.n_allocs());
+            ASSERT_EQ(true, mh.n_frees() <= (n < prev_n ? slabs_for<List<int>>(prev_n) : 0ULL));
 
             // Check consistency of copy
             {
@@ -62,5 +65,23 @@ TEST(operator_copy) {
                     ASSERT_EQ_(*--gt_it, *--it, "An inconsistency was found when iterating backward");    
             }
         }
+
+        // Non-propagating copy assignment keeps the target's allocator
+        {
+            using Alloc = TrackingAllocator<int>;
+            AllocCounter counter, other_counter;
+
+            const size_t n = t.range(0x999ULL);
+            List<int, Alloc> ll(n, 7, Alloc(&counter));
+
+            List<int, Alloc> target { Alloc(&other_counter) };
+            target.push_back(1);
+            target = ll;
+
+            ASSERT_EQ(true, target.get_allocator() == Alloc(&other_counter));
+            ASSERT_EQ(1 + (n > 1 ? slabs_for<List<int, Alloc>>(n - 1) : 0ULL), other_counter.allocs);
+            ASSERT_EQ(n == 0 ? 1ULL : 0ULL, other_counter.frees);
+            ASSERT_EQ(n, target.size());
+        }
     }
 }
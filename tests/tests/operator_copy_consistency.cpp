@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <list>
 #include "executable.h"
+#include "slabs.h"
 
 TEST(operator_copy_consistency) {
     Typegen t;
@@ -23,8 +24,9 @@ TEST(operator_copy_consistency) {
         Memhook mh;
         ll_cpy = const_ll;
 
-        ASSERT_EQ(n, mh.n_allocs());
-        ASSERT_EQ(prev_n, mh.n_frees());
+        // Existing nodes are reused, only the size difference touches the heap
+        ASSERT_EQ(n > prev_n ? slabs_for<List<int>>(n - prev_n) : 0ULL, mh.n_allocs());
+        ASSERT_EQ(true, mh.n_frees() <= (n < prev_n ? slabs_for<List<int>>(prev_n) : 0ULL));
 
         // Check consistancy of copy
         {
@@ -1,6 +1,9 @@
 #include <algorithm>
 #include <list>
+#include <vector>
 #include "executable.h"
+#include "slabs.h"
+#include "tracking_allocator.h"
 
 TEST(operator_move) {
     Typegen t;
@@ -42,7 +45,7 @@ TEST(operator_move) {
 
             // No new allocs and previous memory should have been freed
             ASSERT_EQ(0ULL, mh.n_allocs());
-            ASSERT_EQ(prev_n, mh.n_frees());
+            ASSERT_EQ(slabs_for<List<int>>(prev_n), mh.n_frees());
 
             {
                 // Check consistancy of copy
@@ -75,5 +78,85 @@ TEST(operator_move) {
                     ASSERT_EQ_(*--gt_it, *--it, "An inconsistency was found when iterating backward");
             }
         }
+
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Moves steal nodes from equal allocators and propagate otherwise
+        {
+            using Alloc = TrackingAllocator<int>;
+            AllocCounter counter, other_counter;
+
+            List<int, Alloc> ll { Alloc(&counter) };
+            for(size_t j = 0; j < n; j++)
+                ll.push_back(gt[j]);
+
+            List<int, Alloc> moved = std::move(ll);
+            ASSERT_EQ(n, counter.allocs);
+            ASSERT_EQ(0ULL, ll.size());
+
+            List<int, Alloc> target { Alloc(&other_counter) };
+            target.push_back(1);
+
+            Memhook mh;
+            target = std::move(moved);
+
+            // POCMA: the allocator travels with the nodes
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(true, target.get_allocator() == Alloc(&counter));
+            ASSERT_EQ(1ULL, other_counter.frees);
+            ASSERT_EQ(true, std::equal(gt.cbegin(), gt.cend(), target.cbegin(), target.cend()));
+        }
+
+        // Without POCMA, unequal allocators force an element-wise move
+        {
+            using StickyAlloc = TrackingAllocator<int, false, false, false>;
+            AllocCounter counter, other_counter;
+
+            List<int, StickyAlloc> ll { StickyAlloc(&counter) };
+            for(size_t j = 0; j < n; j++)
+                ll.push_back(gt[j]);
+
+            List<int, StickyAlloc> target { StickyAlloc(&other_counter) };
+            target = std::move(ll);
+
+            ASSERT_EQ(true, target.get_allocator() == StickyAlloc(&other_counter));
+            ASSERT_EQ(n, other_counter.allocs);
+            ASSERT_EQ(n, counter.frees);
+            ASSERT_EQ(0ULL, ll.size());
+            ASSERT_EQ(true, std::equal(gt.cbegin(), gt.cend(), target.cbegin(), target.cend()));
+        }
+
+        // Swap exchanges nodes and propagating allocators in O(1)
+        {
+            using Alloc = TrackingAllocator<int>;
+            AllocCounter counter, other_counter;
+
+            List<int, Alloc> lhs(n, 1, Alloc(&counter));
+            List<int, Alloc> rhs { Alloc(&other_counter) };
+            rhs.push_back(2);
+
+            Memhook mh;
+            swap(lhs, rhs);
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            ASSERT_EQ(1ULL, lhs.size());
+            ASSERT_EQ(n, rhs.size());
+            ASSERT_EQ(true, lhs.get_allocator() == Alloc(&other_counter));
+            ASSERT_EQ(true, rhs.get_allocator() == Alloc(&counter));
+            ASSERT_EQ(2, lhs.front());
+
+            size_t count = 0;
+            for(auto it = rhs.cbegin(); it != rhs.cend(); it++, count++)
+                ASSERT_EQ(1, *it);
+            ASSERT_EQ(n, count);
+
+            count = 0;
+            for(auto it = rhs.cend(); it != rhs.cbegin(); count++)
+                ASSERT_EQ(1, *--it);
+            ASSERT_EQ(n, count);
+        }
     }
 }
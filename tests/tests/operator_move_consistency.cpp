@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <list>
 #include "executable.h"
+#include "slabs.h"
 
 TEST(operator_move_consistency) {
     Typegen t;
@@ -43,7 +44,7 @@ TEST(operator_move_consistency) {
 
             // No new allocs and previous memory should have been freed
             ASSERT_EQ(0ULL, mh.n_allocs());
-            ASSERT_EQ(prev_n, mh.n_frees());
+            ASSERT_EQ(slabs_for<List<int>>(prev_n), mh.n_frees());
 
             // lists should be consistent
             {
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <list>
 #include "executable.h"
+#include "slabs.h"
 
 TEST(pop_front) {
     Typegen t;
@@ -15,15 +16,17 @@ TEST(pop_front) {
 
         {
             while(gt_ll.size() > 0) {
+                const size_t popped = n - gt_ll.size();
                 gt_ll.pop_front();
-                
+
                 {
                     Memhook mh;
                     
                     ll.pop_front();
 
-                    // Should free one node
-                    ASSERT_EQ(1ULL, mh.n_frees());
+                    // Nodes share slabs in order; popping the last node of a slab frees it
+                    const bool slab_emptied = popped + 1 == n || slab_of<List<int>>(popped + 1, n) != slab_of<List<int>>(popped, n);
+                    ASSERT_EQ(slab_emptied ? 1ULL : 0ULL, mh.n_frees());
                     ASSERT_EQ(0ULL, mh.n_allocs());
                 }
 
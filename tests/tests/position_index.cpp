@@ -0,0 +1,178 @@
+#include "executable.h"
+#include "consistency.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template<typename T, typename Layout = pointers_first_layout>
+using IndexedList = List<T, std::allocator<T>, Layout, order_statistic_index>;
+
+// Every position agrees with the ground truth in both directions
+template<typename ListType>
+bool positions_match(ListType & ll, std::vector<int> const & gt) {
+    if(ll.size() != gt.size() || ll.iterator_at(ll.size()) != ll.end() || ll.index_of(ll.end()) != ll.size())
+        return false;
+
+    size_t position = 0;
+    for(auto it = ll.begin(); it != ll.end(); it++, position++)
+        if(ll.at(position) != gt[position] || ll.index_of(it) != position || ll.iterator_at(position) != it)
+            return false;
+    return true;
+}
+
+TEST(position_index) {
+    Typegen t;
+
+    // Plain lists carry no index state in their nodes
+    ASSERT_EQ((List<int>::node_size), (List<int, std::allocator<int>, pointers_first_layout, no_index>::node_size));
+    ASSERT_EQ(true, (IndexedList<int>::node_size > List<int>::node_size));
+
+    // ... nor in the list itself: sentinels, size, allocator and node cache
+    if(sizeof(void *) == 8)
+        ASSERT_EQ(72ULL, sizeof(List<int>));
+
+    // Positions past the end give end() rather than walking off the index
+    {
+        IndexedList<int> ll = {1, 2, 3};
+        ASSERT_EQ(true, ll.iterator_at(3) == ll.end());
+        ASSERT_EQ(true, ll.iterator_at(100) == ll.end());
+        ASSERT_EQ(true, std::as_const(ll).iterator_at(4) == ll.cend());
+    }
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x3FFULL);
+        std::vector<int> values(n);
+        t.fill(values.begin(), values.end());
+
+        // Single-node edits keep the index current
+        {
+            IndexedList<int> ll;
+            std::vector<int> gt;
+
+            for(size_t j = 0; j < n; j++) {
+                const size_t pos = t.range(gt.size() + 1);
+                switch(t.range(6)) {
+                    case 0:
+                        ll.push_front(values[j]);
+                        gt.insert(gt.begin(), values[j]);
+                        break;
+                    case 1:
+                        ll.insert(ll.iterator_at(pos), values[j]);
+                        gt.insert(gt.begin() + pos, values[j]);
+                        break;
+                    case 2:
+                        if(pos < gt.size()) {
+                            ll.erase(ll.iterator_at(pos));
+                            gt.erase(gt.begin() + pos);
+                        }
+                        break;
+                    case 3:
+                        if(!gt.empty()) {
+                            ll.pop_front();
+                            gt.erase(gt.begin());
+                        }
+                        break;
+                    case 4:
+                        if(!gt.empty()) {
+                            ll.pop_back();
+                            gt.pop_back();
+                        }
+                        break;
+                    default:
+                        ll.push_back(values[j]);
+                        gt.push_back(values[j]);
+                        break;
+                }
+
+                if(!gt.empty()) {
+                    const size_t probe = t.range(gt.size());
+                    ASSERT_EQ(gt[probe], ll.at(probe));
+                    ASSERT_EQ(probe, ll.index_of(ll.iterator_at(probe)));
+                }
+            }
+            ASSERT_EQ(true, consistent(ll, gt));
+            ASSERT_EQ(true, positions_match(ll, gt));
+
+            // Out of range positions throw
+            bool threw = false;
+            try {
+                ll.at(gt.size());
+            }
+            catch(std::out_of_range const &) {
+                threw = true;
+            }
+            ASSERT_EQ(true, threw);
+
+            // Bulk operations leave a usable index behind
+            std::vector<int> out(t.range(gt.size() + 1));
+            ll.pop_front_n(out.begin(), out.size());
+            gt.erase(gt.begin(), gt.begin() + out.size());
+            ASSERT_EQ(true, positions_match(ll, gt));
+
+            ll.append_range(values.begin(), values.begin() + t.range(n + 1));
+            gt.insert(gt.end(), values.begin(), values.begin() + (ll.size() - gt.size()));
+            ASSERT_EQ(true, positions_match(ll, gt));
+
+            ll.sort();
+            std::stable_sort(gt.begin(), gt.end());
+            ASSERT_EQ(true, positions_match(ll, gt));
+
+            IndexedList<int> cpy = ll;
+            ASSERT_EQ(true, positions_match(cpy, gt));
+
+            IndexedList<int> moved = std::move(cpy);
+            ASSERT_EQ(true, positions_match(moved, gt));
+            ASSERT_EQ(true, positions_match(cpy, std::vector<int>()));
+
+            ll.clear();
+            ASSERT_EQ(true, positions_match(ll, std::vector<int>()));
+
+            ll.push_back(1);
+            ASSERT_EQ(1, ll.at(0));
+
+            ll.swap(moved);
+            ASSERT_EQ(true, positions_match(ll, gt));
+            ASSERT_EQ(true, positions_match(moved, std::vector<int>{1}));
+        }
+
+        // Splices update both lists' indexes
+        {
+            IndexedList<int, data_first_layout> a(values.begin(), values.end()), b;
+            std::vector<int> gt_a = values, gt_b;
+
+            for(size_t j = 0; j < 32 && !gt_a.empty(); j++) {
+                const size_t from = t.range(gt_a.size());
+                const size_t to = t.range(gt_b.size() + 1);
+                b.splice(b.iterator_at(to), a, a.iterator_at(from));
+                gt_b.insert(gt_b.begin() + to, gt_a[from]);
+                gt_a.erase(gt_a.begin() + from);
+            }
+            ASSERT_EQ(true, positions_match(a, gt_a));
+            ASSERT_EQ(true, positions_match(b, gt_b));
+
+            const size_t first = t.range(gt_a.size() + 1);
+            const size_t last = first + t.range(gt_a.size() - first + 1);
+            const size_t to = t.range(gt_b.size() + 1);
+            b.splice(b.iterator_at(to), a, a.iterator_at(first), a.iterator_at(last));
+            gt_b.insert(gt_b.begin() + to, gt_a.begin() + first, gt_a.begin() + last);
+            gt_a.erase(gt_a.begin() + first, gt_a.begin() + last);
+            ASSERT_EQ(true, positions_match(a, gt_a));
+            ASSERT_EQ(true, positions_match(b, gt_b));
+
+            a.splice(a.iterator_at(t.range(gt_a.size() + 1)), b);
+            ASSERT_EQ(gt_a.size() + gt_b.size(), a.size());
+            ASSERT_EQ(true, b.empty());
+
+            std::vector<int> gt(a.begin(), a.end());
+            ASSERT_EQ(true, positions_match(a, gt));
+            ASSERT_EQ(true, positions_match(b, std::vector<int>()));
+
+            // An empty list takes over the index with the nodes
+            b.splice(b.end(), a);
+            ASSERT_EQ(true, positions_match(b, gt));
+            ASSERT_EQ(true, positions_match(a, std::vector<int>()));
+        }
+    }
+}
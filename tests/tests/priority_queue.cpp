@@ -0,0 +1,255 @@
+#include "executable.h"
+#include "tracking_allocator.h"
+#include "PriorityQueue.h"
+
+#include <functional>
+#include <set>
+#include <vector>
+
+using Heap = PriorityQueue<int>;
+using TrackedHeap = PriorityQueue<int, std::less<int>, TrackingAllocator<int>>;
+
+// Remove the handle referring to the current top from live
+template<typename Q>
+void forget_top(std::vector<typename Q::handle> & live, Q const & q) {
+    for(size_t k = 0; k < live.size(); k++) {
+        if(&*live[k] == &q.top()) {
+            live[k] = live.back();
+            live.pop_back();
+            return;
+        }
+    }
+}
+
+struct Job {
+    int deadline;
+    size_t id;
+};
+
+struct LaterDeadline {
+    bool operator()(Job const & lhs, Job const & rhs) const { return lhs.deadline > rhs.deadline; }
+};
+
+// A key whose assignment throws once armed
+struct Fragile {
+    static inline bool fail_assign = false;
+
+    int key;
+
+    Fragile(int key) : key { key } {}
+    Fragile(Fragile const & other) = default;
+    Fragile & operator=(Fragile const & other) {
+        if(fail_assign)
+            throw 1;
+        key = other.key;
+        return *this;
+    }
+    bool operator<(Fragile const & other) const { return key < other.key; }
+};
+
+TEST(priority_queue) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        // Random pushes, pops and key changes agree with a sorted multiset
+        {
+            AllocCounter counter;
+            Memhook mh;
+
+            {
+                TrackedHeap q { TrackingAllocator<int>(&counter) };
+                std::multiset<int> gt;
+                std::vector<TrackedHeap::handle> live;
+                live.reserve(n);
+
+                size_t allocs = 0;
+
+                for(size_t j = 0; j < n; j++) {
+                    switch(t.range(5)) {
+                        case 0:
+                        case 1: {
+                            const int value = t.range(1000);
+                            live.push_back(j % 2 == 0 ? q.push(value) : q.emplace(value));
+                            gt.insert(value);
+                            allocs++;
+                            ASSERT_EQ(value, *live.back());
+                            break;
+                        }
+                        case 2:
+                            if(!gt.empty()) {
+                                ASSERT_EQ(*gt.rbegin(), q.top());
+                                forget_top(live, q);
+                                gt.erase(std::prev(gt.end()));
+                                q.pop();
+                            }
+                            break;
+                        case 3:
+                            if(!live.empty()) {
+                                // Raise a random element's priority
+                                TrackedHeap::handle h = live[t.range(live.size())];
+                                const int value = *h + t.range(100);
+                                gt.erase(gt.find(*h));
+                                gt.insert(value);
+                                q.decrease_key(h, value);
+                                ASSERT_EQ(value, *h);
+                            }
+                            break;
+                        default:
+                            if(!live.empty()) {
+                                const size_t k = t.range(live.size());
+                                TrackedHeap::handle h = live[k];
+                                gt.erase(gt.find(*h));
+
+                                // Either drop the element or give it any new value
+                                if(t.get<bool>()) {
+                                    live[k] = live.back();
+                                    live.pop_back();
+                                    q.erase(h);
+                                }
+                                else {
+                                    const int value = t.range(1000);
+                                    gt.insert(value);
+                                    q.update(h, value);
+                                    ASSERT_EQ(value, *h);
+                                }
+                            }
+                            break;
+                    }
+
+                    ASSERT_EQ(gt.size(), q.size());
+                    if(!gt.empty())
+                        ASSERT_EQ(*gt.rbegin(), q.top());
+                }
+
+                // Key changes relink nodes without allocating
+                ASSERT_EQ(allocs, counter.allocs);
+
+                // Copies hold the same elements
+                TrackedHeap cpy = q;
+                ASSERT_EQ(q.size(), cpy.size());
+
+                while(!gt.empty()) {
+                    ASSERT_EQ(*gt.rbegin(), cpy.top());
+                    ASSERT_EQ(*gt.rbegin(), q.top());
+                    gt.erase(std::prev(gt.end()));
+                    cpy.pop();
+                    q.pop();
+                }
+
+                ASSERT_EQ(true, q.empty());
+                ASSERT_EQ(true, cpy.empty());
+            }
+
+            ASSERT_EQ(counter.allocs, counter.frees);
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Merging is O(1) and keeps handles into both heaps valid
+        {
+            Memhook mh;
+
+            {
+                Heap lhs, rhs;
+                std::multiset<int> gt;
+                std::vector<Heap::handle> handles;
+                handles.reserve(n);
+
+                for(size_t j = 0; j < n; j++) {
+                    const int value = t.range(1000);
+                    handles.push_back(j % 2 == 0 ? lhs.push(value) : rhs.push(value));
+                    gt.insert(value);
+                }
+
+                const size_t before = mh.n_allocs();
+                lhs.merge(rhs);
+                ASSERT_EQ(before, mh.n_allocs());
+                ASSERT_EQ(n, lhs.size());
+                ASSERT_EQ(true, rhs.empty());
+
+                for(Heap::handle h : handles) {
+                    gt.erase(gt.find(*h));
+                    gt.insert(*h + 1);
+                    lhs.decrease_key(h, *h + 1);
+                }
+
+                // Moves and swaps carry the heap along
+                Heap moved = std::move(lhs);
+                ASSERT_EQ(true, lhs.empty());
+                swap(moved, rhs);
+                ASSERT_EQ(true, moved.empty());
+
+                while(!gt.empty()) {
+                    ASSERT_EQ(*gt.rbegin(), rhs.top());
+                    gt.erase(std::prev(gt.end()));
+                    rhs.pop();
+                }
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Jobs come out earliest deadline first, and can be pulled forward
+        {
+            PriorityQueue<Job, LaterDeadline> jobs;
+            std::vector<PriorityQueue<Job, LaterDeadline>::handle> handles;
+
+            for(size_t j = 0; j < n; j++)
+                handles.push_back(jobs.push(Job { static_cast<int>(t.range(1000)) + 1, j }));
+
+            if(n > 0) {
+                const size_t urgent = t.range(n);
+                jobs.decrease_key(handles[urgent], Job { 0, urgent });
+                ASSERT_EQ(urgent, jobs.top().id);
+            }
+
+            int last = 0;
+            while(!jobs.empty()) {
+                ASSERT_EQ(true, last <= jobs.top().deadline);
+                last = jobs.top().deadline;
+                jobs.pop();
+            }
+        }
+
+        // A throwing assignment in update leaves the element in the heap
+        {
+            PriorityQueue<Fragile> q;
+            std::multiset<int> gt;
+            std::vector<PriorityQueue<Fragile>::handle> handles;
+
+            for(size_t j = 0; j < n; j++) {
+                const int value = t.range(1000) + 1;
+                handles.push_back(q.push(Fragile(value)));
+                gt.insert(value);
+            }
+
+            if(n > 0) {
+                PriorityQueue<Fragile>::handle h = handles[t.range(n)];
+                const int old_key = h->key;
+
+                // Lowering the key takes the unlink path
+                Fragile::fail_assign = true;
+                bool threw = false;
+                try {
+                    q.update(h, Fragile(0));
+                }
+                catch(int) {
+                    threw = true;
+                }
+                Fragile::fail_assign = false;
+
+                ASSERT_EQ(true, threw);
+                ASSERT_EQ(old_key, h->key);
+                ASSERT_EQ(n, q.size());
+            }
+
+            while(!gt.empty()) {
+                ASSERT_EQ(*gt.rbegin(), q.top().key);
+                gt.erase(std::prev(gt.end()));
+                q.pop();
+            }
+            ASSERT_EQ(true, q.empty());
+        }
+    }
+}
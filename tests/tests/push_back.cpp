@@ -1,5 +1,6 @@
 #include "executable.h"
 #include "box.h"
+#include "tracking_allocator.h"
 
 #include <vector>
 
@@ -77,6 +78,33 @@ TEST(push_back) {
             ASSERT_EQ(n, mh.n_scoped_frees());
             ASSERT_EQ(2 * n + 1, mh.n_frees());
         }
+
+        // Every node should be served by the supplied allocator
+        {
+            using Alloc = TrackingAllocator<int>;
+            AllocCounter counter;
+
+            Memhook mh;
+
+            {
+                List<int, Alloc> ll { Alloc(&counter) };
+
+                for(size_t i = 0; i < n; i++)
+                    ll.push_back(gt[i]);
+
+                ASSERT_EQ(n, counter.allocs);
+                ASSERT_EQ(n, mh.n_allocs());
+                ASSERT_EQ(true, ll.get_allocator() == Alloc(&counter));
+
+                size_t j = 0;
+                for(auto it = ll.cbegin(); it != ll.cend(); it++)
+                    ASSERT_EQ(gt[j++], *it);
+            }
+
+            // The destructor returns everything through the allocator
+            ASSERT_EQ(counter.allocs, counter.frees);
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
     }
     
 }
@@ -24,8 +24,8 @@ TEST(queue_equality_operator) {
 
             // Populate the queues with the refernce vector data
             for (size_t j = 0; j < n; j++) {
-                q1.push(gt_1[i]);
-                q2.push(gt_1[i]);
+                q1.push(gt_1[j]);
+                q2.push(gt_1[j]);
             }
 
             // Check that the queues were properly setup
@@ -34,8 +34,20 @@ TEST(queue_equality_operator) {
             ASSERT_EQ(2 * n, mh.n_allocs());
         }
 
-        // The queues should have the same data
-        ASSERT_EQ(true, q1 == q2);
+        // The queues should have the same data, and comparing them
+        // should neither copy nor allocate
+        {
+            Memhook mh;
+
+            ASSERT_EQ(true, q1 == q2);
+            ASSERT_EQ(false, q1 != q2);
+            ASSERT_EQ(false, q1 < q2);
+            ASSERT_EQ(true, q1 <= q2);
+            ASSERT_EQ(true, q1 >= q2);
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
 
         // Generate a different reference vector
         std::vector<int> gt_2(n);
@@ -48,7 +60,7 @@ TEST(queue_equality_operator) {
 
             // Populate the queue with the reference vector data
             for (size_t j = 0; j < n; j++) {
-                q3.push(gt_2[i]);
+                q3.push(gt_2[j]);
             }
 
             // Ensure that the queue was properly setup
@@ -56,9 +68,20 @@ TEST(queue_equality_operator) {
             ASSERT_EQ(n, mh.n_allocs());
         }
 
-        // The queues should be different
-        ASSERT_EQ(false, q1 == q3);
-        ASSERT_EQ(false, q3 == q2);
+        // The queues should be different and order like their contents
+        {
+            Memhook mh;
+
+            ASSERT_EQ(gt_1 == gt_2, q1 == q3);
+            ASSERT_EQ(gt_2 == gt_1, q3 == q2);
+            ASSERT_EQ(gt_1 != gt_2, q1 != q3);
+            ASSERT_EQ(gt_1 < gt_2, q1 < q3);
+            ASSERT_EQ(gt_1 > gt_2, q1 > q3);
+            ASSERT_EQ(gt_2 <= gt_1, q3 <= q1);
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
 
         // Comparisons between queues of different sizes should be false
         // Generate a smaller reference vector
@@ -73,7 +96,7 @@ TEST(queue_equality_operator) {
 
             // Populate the queue with the smaller reference vector
             for (size_t j = 0; j < n_smaller; j++) {
-                q4.push(gt_3[i]);
+                q4.push(gt_3[j]);
             }
 
             // Ensure the queue was properly setup
@@ -82,8 +105,17 @@ TEST(queue_equality_operator) {
         }
 
         // Queues of different sizes should always be false
-        ASSERT_EQ(false, q1 == q4);
-        ASSERT_EQ(false, q4 == q3);
+        {
+            Memhook mh;
+
+            ASSERT_EQ(false, q1 == q4);
+            ASSERT_EQ(false, q4 == q3);
+            ASSERT_EQ(true, q4 != q3);
+            ASSERT_EQ(gt_3 < gt_2, q4 < q3);
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
 
     }
 }
\ No newline at end of file
@@ -36,5 +36,38 @@ TEST(queue_push_pop_and_empty) {
         // Queue should once again be empty
         ASSERT_EQ(true, q.empty());
         ASSERT_EQ(0ULL, q.size());
+
+        // A queue recycling its nodes should not allocate once warm
+        List<int> recycling;
+        recycling.set_node_cache_limit(n);
+        Queue<int> warm_q(std::move(recycling));
+
+        for (size_t i = 0; i < n; i++) {
+            warm_q.push(gt[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+            warm_q.pop();
+        }
+
+        {
+            Memhook warm_mh;
+
+            for (size_t round = 0; round < 4; round++) {
+                for (size_t i = 0; i < n; i++) {
+                    warm_q.push(gt[i]);
+                }
+                ASSERT_EQ(n, warm_q.size());
+                ASSERT_EQ(gt[0], warm_q.front());
+
+                for (size_t i = 0; i < n; i++) {
+                    ASSERT_EQ(gt[i], warm_q.front());
+                    warm_q.pop();
+                }
+            }
+
+            ASSERT_EQ(true, warm_q.empty());
+            ASSERT_EQ(0ULL, warm_mh.n_allocs());
+            ASSERT_EQ(0ULL, warm_mh.n_frees());
+        }
     }
 }
\ No newline at end of file
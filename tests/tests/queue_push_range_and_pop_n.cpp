@@ -0,0 +1,219 @@
+#include "executable.h"
+#include "consistency.h"
+#include "slabs.h"
+#include "Queue.h"
+#include "Deque.h"
+#include "box.h"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <vector>
+
+// Throws from its copy constructor once armed copies have been made
+struct Fragile {
+    static inline size_t copies_left = 0;
+    static inline bool armed = false;
+
+    int value;
+
+    Fragile(int value) : value { value } {}
+    Fragile(Fragile const & other) : value { other.value } {
+        if(armed && copies_left-- == 0)
+            throw 1;
+    }
+    Fragile & operator=(Fragile const & other) = default;
+};
+
+TEST(queue_push_range_and_pop_n) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // A measurable batch takes one allocation per slab, and popping
+        // the whole batch frees exactly those slabs
+        {
+            Queue<int> q;
+            std::vector<int> out(n);
+
+            Memhook mh;
+
+            q.push_range(gt.begin(), gt.end());
+            ASSERT_EQ(slabs_for<List<int>>(n), mh.n_allocs());
+            ASSERT_EQ(n, q.size());
+            if(n > 0) {
+                ASSERT_EQ(gt.front(), q.front());
+                ASSERT_EQ(gt.back(), q.back());
+            }
+
+            const size_t first = t.range(n + 1);
+            ASSERT_EQ(first, q.pop_n(out.begin(), first));
+            ASSERT_EQ(n - first, q.size());
+
+            // Asking for more than is queued pops what there is
+            ASSERT_EQ(n - first, q.pop_n(out.begin() + first, n + 1));
+            ASSERT_EQ(true, q.empty());
+            ASSERT_EQ(true, out == gt);
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Batches interleave with single pushes and pops
+        {
+            Memhook mh;
+
+            {
+                List<int> ll;
+                std::list<int> gt_ll;
+                std::vector<int> out;
+                out.reserve(n);
+
+                for(size_t j = 0; j < n; ) {
+                    const size_t batch = t.range(16ULL);
+
+                    switch(t.range(3)) {
+                        case 0: {
+                            const size_t end = j + batch < n ? j + batch : n;
+                            ll.append_range(gt.begin() + j, gt.begin() + end);
+                            gt_ll.insert(gt_ll.end(), gt.begin() + j, gt.begin() + end);
+                            j = end;
+                            break;
+                        }
+                        case 1:
+                            ll.push_back(gt[j]);
+                            gt_ll.push_back(gt[j]);
+                            j++;
+                            break;
+                        default: {
+                            const size_t popped = ll.pop_front_n(std::back_inserter(out), batch);
+                            ASSERT_EQ(batch < gt_ll.size() ? batch : gt_ll.size(), popped);
+                            for(size_t k = 0; k < popped; k++) {
+                                ASSERT_EQ(gt_ll.front(), out[out.size() - popped + k]);
+                                gt_ll.pop_front();
+                            }
+                            break;
+                        }
+                    }
+
+                    ASSERT_EQ(gt_ll.size(), ll.size());
+                }
+
+                ASSERT_EQ(true, consistent(ll, gt_ll));
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Batches reuse cached nodes before allocating any
+        {
+            List<int> ll;
+            std::vector<int> out(n);
+            ll.set_node_cache_limit(n);
+            ll.append_range(gt.begin(), gt.end());
+            ASSERT_EQ(n, ll.pop_front_n(out.begin(), n));
+
+            Memhook mh;
+            ll.append_range(gt.begin(), gt.end());
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            ASSERT_EQ(true, consistent(ll, gt));
+        }
+
+        // A batch too small to pay for a slab header gets nodes of its own
+        {
+            const size_t small = std::min<size_t>(t.range(List<int>::min_slab_nodes), n);
+            Memhook mh;
+            {
+                List<int> ll;
+                ll.append_range(gt.begin(), gt.begin() + small);
+                ASSERT_EQ(small, mh.n_allocs());
+                for(size_t j = 0; j < mh.n_blocks(); j++)
+                    ASSERT_EQ(List<int>::node_size, mh[j].size);
+            }
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Single-pass ranges are appended a node at a time
+        {
+            std::stringstream ss;
+            for(size_t j = 0; j < n; j++)
+                ss << gt[j] << ' ';
+
+            List<int> ll;
+            {
+                Memhook mh;
+                ll.append_range(std::istream_iterator<int>(ss), std::istream_iterator<int>());
+                ASSERT_EQ(n, mh.n_allocs());
+            }
+            ASSERT_EQ(true, consistent(ll, gt));
+        }
+
+        // Elements are moved, not copied, out of a batch
+        {
+            Queue<Box<int>> q;
+            std::vector<Box<int>> boxes(gt.begin(), gt.end());
+            q.push_range(boxes.begin(), boxes.end());
+
+            std::vector<Box<int>> out(n);
+
+            Memhook mh;
+            ASSERT_EQ(n, q.pop_n(out.begin(), n));
+
+            // The payloads move to out; only the slabs are freed
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(slabs_for<List<Box<int>>>(n), mh.n_frees());
+
+            for(size_t j = 0; j < n; j++)
+                ASSERT_EQ(gt[j], *out[j]);
+        }
+
+        // A throwing copy keeps the elements built before it
+        {
+            Memhook mh;
+
+            {
+                std::vector<Fragile> values(gt.begin(), gt.end());
+                const size_t fail_at = t.range(n + 1);
+
+                List<Fragile> ll;
+                Fragile::copies_left = fail_at;
+                Fragile::armed = true;
+
+                bool threw = false;
+                try {
+                    ll.append_range(values.begin(), values.end());
+                }
+                catch(int) {
+                    threw = true;
+                }
+                Fragile::armed = false;
+
+                ASSERT_EQ(fail_at < n, threw);
+                ASSERT_EQ(fail_at < n ? fail_at : n, ll.size());
+
+                size_t j = 0;
+                for(Fragile const & f : ll)
+                    ASSERT_EQ(gt[j++], f.value);
+                ASSERT_EQ(ll.size(), j);
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Deque supports the batched calls too
+        {
+            Queue<int, Deque<int>> q;
+            std::vector<int> out(n);
+
+            q.push_range(gt.begin(), gt.end());
+            ASSERT_EQ(n, q.size());
+            ASSERT_EQ(n, q.pop_n(out.begin(), n));
+            ASSERT_EQ(true, q.empty());
+            ASSERT_EQ(true, out == gt);
+        }
+    }
+}
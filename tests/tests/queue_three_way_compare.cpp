@@ -0,0 +1,91 @@
+#include "executable.h"
+#include "Queue.h"
+#include "Deque.h"
+
+#include <compare>
+#include <vector>
+
+// <=> must order two queues exactly as < and == do
+template<typename Q>
+bool agrees(Q const & lhs, Q const & rhs) {
+    const auto order = lhs <=> rhs;
+    return (order < 0) == (lhs < rhs)
+        && (order == 0) == (lhs == rhs)
+        && (order > 0) == (lhs > rhs);
+}
+
+template<typename Q>
+Q make_queue(std::vector<int> const & values, size_t count) {
+    Q q;
+    for(size_t j = 0; j < count; j++)
+        q.push(values[j]);
+    return q;
+}
+
+TEST(queue_three_way_compare) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(1ULL, 0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Equal queues compare equal
+        {
+            Queue<int> q1 = make_queue<Queue<int>>(gt, n);
+            Queue<int> q2 = make_queue<Queue<int>>(gt, n);
+
+            ASSERT_EQ(true, (q1 <=> q2) == 0);
+            ASSERT_EQ(true, agrees(q1, q2));
+        }
+
+        // A proper prefix orders before the whole queue
+        {
+            const size_t prefix = t.range(n);
+            Queue<int> whole = make_queue<Queue<int>>(gt, n);
+            Queue<int> front = make_queue<Queue<int>>(gt, prefix);
+
+            ASSERT_EQ(true, (front <=> whole) < 0);
+            ASSERT_EQ(true, (whole <=> front) > 0);
+            ASSERT_EQ(true, agrees(front, whole));
+            ASSERT_EQ(true, agrees(whole, front));
+        }
+
+        // Queues that differ order like their first differing element
+        {
+            std::vector<int> other = gt;
+            const size_t at = t.range(n);
+            other[at] = t.get<int>();
+
+            Queue<int> q1 = make_queue<Queue<int>>(gt, n);
+            Queue<int> q2 = make_queue<Queue<int>>(other, n);
+
+            ASSERT_EQ(true, (q1 <=> q2) == (gt[at] <=> other[at]));
+            ASSERT_EQ(true, (q1 <=> q2) == (gt <=> other));
+            ASSERT_EQ(true, agrees(q1, q2));
+            ASSERT_EQ(true, agrees(q2, q1));
+        }
+
+        // Comparing neither copies nor allocates
+        {
+            Queue<int> q1 = make_queue<Queue<int>>(gt, n);
+            Queue<int> q2 = make_queue<Queue<int>>(gt, t.range(n + 1));
+
+            Memhook mh;
+            ASSERT_EQ(true, agrees(q1, q2));
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+
+        // Other containers compare the same way
+        {
+            using DequeQueue = Queue<int, Deque<int>>;
+            const size_t prefix = t.range(n + 1);
+            DequeQueue q1 = make_queue<DequeQueue>(gt, n);
+            DequeQueue q2 = make_queue<DequeQueue>(gt, prefix);
+
+            ASSERT_EQ(true, agrees(q1, q2));
+            ASSERT_EQ(true, agrees(q2, q1));
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#include "executable.h"
+#include "consistency.h"
+#include "instrumented.h"
+
+#include <list>
+
+struct NoDefault {
+    int value;
+    explicit NoDefault(int value) : value { value } {}
+
+    bool operator==(NoDefault const & other) const { return value == other.value; }
+    bool operator!=(NoDefault const & other) const { return value != other.value; }
+};
+
+struct BigStruct {
+    char payload[4096];
+};
+
+TEST(sentinel) {
+    Typegen t;
+
+    // The sentinels do not carry a T, so the list's footprint is independent of it
+    ASSERT_EQ(sizeof(List<char>), sizeof(List<BigStruct>));
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        // Empty lists construct no elements and allocate nothing
+        {
+            Instrumented::reset();
+            Memhook mh;
+
+            {
+                List<Instrumented> ll;
+                List<Instrumented> moved = std::move(ll);
+                ASSERT_EQ(true, moved.begin() == moved.end());
+            }
+
+            ASSERT_EQ(0ULL, Instrumented::constructions);
+            ASSERT_EQ(0ULL, Instrumented::copies);
+            ASSERT_EQ(0ULL, Instrumented::moves);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+
+        // T need not be default constructible
+        {
+            List<NoDefault> ll;
+            std::list<NoDefault> gt_ll;
+
+            for(size_t j = 0; j < n; j++) {
+                const int value = t.get<int>();
+                if(j % 2) {
+                    ll.emplace_back(value);
+                    gt_ll.emplace_back(value);
+                } else {
+                    ll.push_front(NoDefault(value));
+                    gt_ll.push_front(NoDefault(value));
+                }
+            }
+
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+
+            List<NoDefault> cpy = ll;
+            ASSERT_EQ(true, consistent(cpy, gt_ll));
+
+            cpy.clear();
+            cpy = std::move(ll);
+            ASSERT_EQ(true, consistent(cpy, gt_ll));
+
+            if(n > 1) {
+                cpy.pop_back();
+                cpy.pop_front();
+                gt_ll.pop_back();
+                gt_ll.pop_front();
+                ASSERT_EQ(true, consistent(cpy, gt_ll));
+            }
+        }
+    }
+}
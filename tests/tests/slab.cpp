@@ -0,0 +1,136 @@
+#include "executable.h"
+#include "consistency.h"
+#include "slabs.h"
+#include "box.h"
+
+#include <list>
+#include <sstream>
+#include <vector>
+#include <iterator>
+
+// Nodes of one slab are laid out at a constant stride in traversal order
+template<typename ListType>
+bool sequential(ListType const & ll) {
+    size_t index = 0;
+    std::ptrdiff_t stride = 0;
+    char const * prev = nullptr;
+
+    for(auto it = ll.cbegin(); it != ll.cend(); it++, index++) {
+        char const * current = reinterpret_cast<char const *>(&(*it));
+
+        if(index % ListType::slab_capacity != 0) {
+            if(stride == 0)
+                stride = current - prev;
+            if(stride <= 0 || current - prev != stride)
+                return false;
+        }
+
+        prev = current;
+    }
+
+    return true;
+}
+
+TEST(slab) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Bulk constructors allocate a handful of slabs in traversal order
+        {
+            Memhook mh;
+
+            List<int> filled(n, 7);
+            ASSERT_EQ(slabs_for<List<int>>(n), mh.n_allocs());
+            ASSERT_EQ(true, sequential(filled));
+
+            List<int> ranged(gt.begin(), gt.end());
+            ASSERT_EQ(2 * slabs_for<List<int>>(n), mh.n_allocs());
+            ASSERT_EQ(true, sequential(ranged));
+            ASSERT_EQ(true, consistent(ranged, gt));
+
+            List<int> cpy = ranged;
+            ASSERT_EQ(3 * slabs_for<List<int>>(n), mh.n_allocs());
+            ASSERT_EQ(true, sequential(cpy));
+            ASSERT_EQ(true, consistent(cpy, gt));
+        }
+
+        // Initializer lists and single-pass ranges
+        {
+            List<int> init { 1, 2, 3, 4 };
+            std::vector<int> gt_init { 1, 2, 3, 4 };
+            ASSERT_EQ(true, consistent(init, gt_init));
+
+            std::stringstream ss;
+            for(int value : gt)
+                ss << value << ' ';
+
+            Memhook mh;
+
+            List<int> streamed { std::istream_iterator<int>(ss), std::istream_iterator<int>() };
+            ASSERT_EQ(true, consistent(streamed, gt));
+            ASSERT_EQ(n, mh.n_allocs());
+        }
+
+        // A slab is released once its last node is
+        {
+            Memhook mh_mem_loss;
+
+            {
+                List<int> ll(gt.begin(), gt.end());
+
+                Memhook mh;
+                size_t remaining = n;
+                while(remaining > 0) {
+                    if(t.get<bool>())
+                        ll.pop_front();
+                    else
+                        ll.pop_back();
+                    remaining--;
+
+                    ASSERT_EQ(true, mh.n_frees() <= slabs_for<List<int>>(n));
+                }
+
+                ASSERT_EQ(slabs_for<List<int>>(n), mh.n_frees());
+                ASSERT_EQ(0ULL, mh.n_allocs());
+            }
+
+            ASSERT_EQ(mh_mem_loss.n_allocs(), mh_mem_loss.n_frees());
+        }
+
+        // Slab nodes outlive the list that allocated them when spliced away
+        {
+            Memhook mh_mem_loss;
+
+            {
+                List<Box<int>> dst;
+
+                {
+                    List<Box<int>> src(gt.begin(), gt.end());
+                    auto middle = src.cbegin();
+                    std::advance(middle, n / 2);
+                    dst.splice(dst.cend(), src, middle, src.cend());
+
+                    // Mix in individually allocated and recycled nodes
+                    src.set_node_cache_limit(n);
+                    src.push_back(1);
+                    for(size_t j = 0; j < n / 4; j++)
+                        src.pop_front();
+                    src.push_front(2);
+                }
+
+                std::vector<int> gt_dst(gt.begin() + n / 2, gt.end());
+                ASSERT_EQ(gt_dst.size(), dst.size());
+
+                auto it = dst.cbegin();
+                for(size_t j = 0; j < gt_dst.size(); j++)
+                    ASSERT_EQ(gt_dst[j], **it++);
+            }
+
+            ASSERT_EQ(mh_mem_loss.n_allocs(), mh_mem_loss.n_frees());
+        }
+    }
+}
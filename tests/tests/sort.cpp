@@ -0,0 +1,78 @@
+#include "executable.h"
+#include "consistency.h"
+#include "box.h"
+
+#include <algorithm>
+#include <list>
+#include <utility>
+#include <vector>
+
+TEST(sort) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = i < 3 ? i : t.range(0x999ULL);
+
+        // Sorting relinks nodes without allocating
+        {
+            List<Box<int>> ll;
+            std::list<Box<int>> gt_ll;
+
+            for(size_t j = 0; j < n; j++) {
+                const int value = t.get<int>();
+                ll.push_back(value);
+                gt_ll.push_back(value);
+            }
+
+            std::vector<Box<int> const *> addresses;
+            for(auto it = ll.cbegin(); it != ll.cend(); it++)
+                addresses.push_back(&(*it));
+
+            Memhook mh;
+            ll.sort();
+            gt_ll.sort();
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+
+            // Every element still lives in its original node
+            std::vector<Box<int> const *> sorted_addresses;
+            for(auto it = ll.cbegin(); it != ll.cend(); it++)
+                sorted_addresses.push_back(&(*it));
+
+            std::sort(addresses.begin(), addresses.end());
+            std::sort(sorted_addresses.begin(), sorted_addresses.end());
+            ASSERT_EQ(true, addresses == sorted_addresses);
+
+            // The sorted list is fully usable
+            ll.push_front(0);
+            ll.push_back(0);
+            ASSERT_EQ(n + 2, ll.size());
+        }
+
+        // Sorting is stable and honours the comparator
+        {
+            using Pair = std::pair<int, size_t>;
+
+            List<Pair> ll;
+            std::list<Pair> gt_ll;
+
+            for(size_t j = 0; j < n; j++) {
+                // Few distinct keys so that ties are common
+                const Pair value { t.range(16), j };
+                ll.push_back(value);
+                gt_ll.push_back(value);
+            }
+
+            auto by_key_desc = [](Pair const & l, Pair const & r) { return l.first > r.first; };
+
+            Memhook mh;
+            ll.sort(by_key_desc);
+            gt_ll.sort(by_key_desc);
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(true, consistent(ll, gt_ll));
+        }
+    }
+}
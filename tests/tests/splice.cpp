@@ -0,0 +1,140 @@
+#include "executable.h"
+#include "consistency.h"
+
+#include <list>
+#include <vector>
+
+TEST(splice) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        const size_t m = t.range(0x999ULL);
+
+        List<int> src, dst;
+        std::list<int> gt_src, gt_dst;
+
+        for(size_t j = 0; j < n; j++) {
+            const int value = t.get<int>();
+            src.push_back(value);
+            gt_src.push_back(value);
+        }
+        for(size_t j = 0; j < m; j++) {
+            const int value = t.get<int>();
+            dst.push_back(value);
+            gt_dst.push_back(value);
+        }
+
+        // Single elements move between lists without allocating
+        {
+            Memhook mh;
+
+            for(size_t j = 0; j < n / 4; j++) {
+                const size_t from = t.range(gt_src.size());
+                const size_t to = t.range(gt_dst.size() + 1);
+
+                auto it = src.begin();
+                auto gt_it = gt_src.begin();
+                std::advance(it, from);
+                std::advance(gt_it, from);
+
+                auto pos = dst.begin();
+                auto gt_pos = gt_dst.begin();
+                std::advance(pos, to);
+                std::advance(gt_pos, to);
+
+                int * address = &(*it);
+                dst.splice(pos, src, it);
+                gt_dst.splice(gt_pos, gt_src, gt_it);
+
+                // The node itself is relinked, not copied
+                ASSERT_EQ(address, &(*--pos));
+            }
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            ASSERT_EQ(true, consistent(src, gt_src));
+            ASSERT_EQ(true, consistent(dst, gt_dst));
+        }
+
+        // Ranges, both across lists and within one list
+        {
+            Memhook mh;
+
+            for(size_t j = 0; j < 8 && !gt_src.empty(); j++) {
+                const size_t first = t.range(gt_src.size());
+                const size_t last = t.range(first, gt_src.size() + 1);
+                const size_t to = t.range(gt_dst.size() + 1);
+
+                auto f = src.cbegin(), l = src.cbegin();
+                auto gt_f = gt_src.cbegin(), gt_l = gt_src.cbegin();
+                std::advance(f, first);
+                std::advance(l, last);
+                std::advance(gt_f, first);
+                std::advance(gt_l, last);
+
+                auto pos = dst.cbegin();
+                auto gt_pos = gt_dst.cbegin();
+                std::advance(pos, to);
+                std::advance(gt_pos, to);
+
+                dst.splice(pos, src, f, l);
+                gt_dst.splice(gt_pos, gt_src, gt_f, gt_l);
+
+                ASSERT_EQ(true, consistent(src, gt_src));
+                ASSERT_EQ(true, consistent(dst, gt_dst));
+            }
+
+            // Rotate a prefix of dst to its end
+            const size_t k = t.range(gt_dst.size() + 1);
+            auto l = dst.cbegin();
+            auto gt_l = gt_dst.cbegin();
+            std::advance(l, k);
+            std::advance(gt_l, k);
+
+            dst.splice(dst.cend(), dst, dst.cbegin(), l);
+            gt_dst.splice(gt_dst.cend(), gt_dst, gt_dst.cbegin(), gt_l);
+            ASSERT_EQ(true, consistent(dst, gt_dst));
+
+            // Splicing an element onto itself is a no-op
+            if(!gt_dst.empty()) {
+                dst.splice(dst.cbegin(), dst, dst.cbegin());
+                dst.splice(++dst.cbegin(), dst, dst.cbegin());
+                ASSERT_EQ(true, consistent(dst, gt_dst));
+            }
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+
+        // Whole lists move in constant time
+        {
+            Memhook mh;
+
+            const size_t to = t.range(gt_src.size() + 1);
+            auto pos = src.begin();
+            auto gt_pos = gt_src.begin();
+            std::advance(pos, to);
+            std::advance(gt_pos, to);
+
+            src.splice(pos, dst);
+            gt_src.splice(gt_pos, gt_dst);
+
+            ASSERT_EQ(true, consistent(src, gt_src));
+            ASSERT_EQ(0ULL, dst.size());
+            ASSERT_EQ(true, dst.begin() == dst.end());
+
+            // The emptied list is still usable
+            dst.push_back(1);
+            dst.splice(dst.cbegin(), List<int>(2, 3));
+            ASSERT_EQ(3ULL, dst.size());
+            ASSERT_EQ(3, dst.front());
+            ASSERT_EQ(1, dst.back());
+
+            src.splice(src.cend(), dst);
+            src.splice(src.cend(), dst);
+            ASSERT_EQ(gt_src.size() + 3, src.size());
+            ASSERT_EQ(1, src.back());
+        }
+    }
+}
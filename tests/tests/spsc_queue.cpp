@@ -0,0 +1,167 @@
+#include "executable.h"
+#include "SpscQueue.h"
+
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
+
+// Counts live instances so leaks and double destruction show up
+struct Counted {
+    static inline long live = 0;
+
+    int value;
+
+    Counted(int value = 0) : value { value } { live++; }
+    Counted(Counted const & other) : value { other.value } { live++; }
+    Counted & operator=(Counted const & other) = default;
+    ~Counted() { live--; }
+};
+
+TEST(spsc_queue) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        const size_t requested = 1 + t.range(0xFFULL);
+
+        // Capacity is rounded up to a power of two
+        {
+            SpscQueue<int> q(requested);
+            const size_t capacity = q.capacity();
+
+            ASSERT_EQ(0ULL, capacity & (capacity - 1));
+            ASSERT_EQ(true, capacity >= requested && capacity < 2 * requested + 2);
+        }
+
+        // Wrapping around the ring preserves FIFO order without allocating
+        {
+            SpscQueue<int> q(requested);
+            std::list<int> gt;
+
+            Memhook mh;
+
+            for(size_t j = 0; j < n; j++) {
+                const int value = t.get<int>();
+
+                if(t.get<bool>(0.45) && !gt.empty()) {
+                    ASSERT_EQ(gt.front(), q.front());
+                    q.pop();
+                    gt.pop_front();
+                } else if(gt.size() == q.capacity()) {
+                    ASSERT_EQ(false, q.try_push(value));
+                } else {
+                    ASSERT_EQ(true, q.try_push(value));
+                    gt.push_back(value);
+                }
+
+                ASSERT_EQ(gt.size(), q.size());
+                ASSERT_EQ(gt.empty(), q.empty());
+
+                // Queries work through a const view of the queue
+                auto const & cq = q;
+                ASSERT_EQ(gt.empty(), cq.empty());
+            }
+
+            int popped = 0;
+            while(!gt.empty()) {
+                ASSERT_EQ(true, q.try_pop(popped));
+                ASSERT_EQ(gt.front(), popped);
+                gt.pop_front();
+            }
+            ASSERT_EQ(false, q.try_pop(popped));
+
+            // Only the ground truth's nodes were allocated
+            ASSERT_EQ(mh.n_frees(), mh.n_allocs());
+        }
+
+        // Bulk operations move as much as fits
+        {
+            SpscQueue<int> q(requested);
+            std::vector<int> in(n), out(n);
+            t.fill(in.begin(), in.end());
+
+            size_t pushed = 0, popped = 0;
+            while(popped < n) {
+                const size_t burst = 1 + t.range(2 * q.capacity());
+
+                const size_t room = q.capacity() - q.size();
+                const size_t wanted = std::min(burst, n - pushed);
+                const size_t count = q.push_n(in.begin() + pushed, wanted);
+                ASSERT_EQ(std::min(room, wanted), count);
+                pushed += count;
+
+                const size_t ready = q.size();
+                const size_t taken = q.pop_n(out.begin() + popped, burst);
+                ASSERT_EQ(std::min(ready, burst), taken);
+                popped += taken;
+            }
+
+            ASSERT_EQ(true, in == out);
+            ASSERT_EQ(true, q.empty());
+        }
+
+        // Elements left in the ring are destroyed with it
+        {
+            {
+                SpscQueue<Counted> q(requested);
+                for(size_t j = 0; j < n && j < q.capacity(); j++)
+                    q.emplace(int(j));
+                if(!q.empty())
+                    q.pop();
+            }
+            ASSERT_EQ(0L, Counted::live);
+        }
+    }
+
+    // A producer and a consumer thread hand over every element in order
+    for(size_t i = 0; i < 8; i++) {
+        const size_t n = 0xFFFF;
+        SpscQueue<size_t> q(16 + t.range(0x3FFULL));
+        std::atomic<bool> in_order { true };
+
+        std::thread producer([&] {
+            std::vector<size_t> burst;
+            for(size_t j = 0; j < n; ) {
+                if(j % 3 == 0) {
+                    q.push(j++);
+                } else {
+                    burst.clear();
+                    for(size_t k = 0; k < 16 && j + k < n; k++)
+                        burst.push_back(j + k);
+                    const size_t count = q.push_n(burst.begin(), burst.size());
+                    if(count == 0)
+                        std::this_thread::yield();
+                    j += count;
+                }
+            }
+        });
+
+        std::thread consumer([&] {
+            size_t expected = 0;
+            size_t burst[16];
+            while(expected < n) {
+                if(expected % 2 == 0) {
+                    size_t value;
+                    if(!q.try_pop(value))
+                        std::this_thread::yield();
+                    else if(value != expected++)
+                        in_order = false;
+                } else {
+                    const size_t count = q.pop_n(burst, 16);
+                    if(count == 0)
+                        std::this_thread::yield();
+                    for(size_t k = 0; k < count; k++)
+                        if(burst[k] != expected++)
+                            in_order = false;
+                }
+            }
+        });
+
+        producer.join();
+        consumer.join();
+
+        ASSERT_EQ(true, in_order.load());
+        ASSERT_EQ(true, q.empty());
+    }
+}
@@ -0,0 +1,204 @@
+#include "executable.h"
+#include "consistency.h"
+#include "UnrolledList.h"
+#include "Queue.h"
+#include "box.h"
+
+#include <list>
+#include <vector>
+
+TEST(unrolled_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        // Chunks are filled before new ones are allocated
+        {
+            Memhook mh;
+
+            {
+                UnrolledList<int, 16> ll;
+
+                for(size_t j = 0; j < n; j++)
+                    ll.push_back(gt[j]);
+
+                ASSERT_EQ((n + 15) / 16, mh.n_allocs());
+                ASSERT_EQ(n, ll.size());
+                ASSERT_EQ(true, consistent(ll, gt));
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Front pops leave the other elements in place and free a front slot
+        {
+            Memhook mh;
+
+            {
+                const size_t full = n / 16 * 16;
+                UnrolledList<int, 16> ll;
+                std::vector<int const *> addresses;
+
+                for(size_t j = 0; j < full; j++)
+                    ll.push_back(gt[j]);
+                for(auto const & value : ll)
+                    addresses.push_back(&value);
+
+                const size_t allocs = mh.n_allocs();
+                for(size_t j = 0; j < full; j++) {
+                    ASSERT_EQ(addresses[j], &ll.front());
+                    ll.pop_front();
+
+                    // Pushing it back refills the slot just freed
+                    if(j % 16 != 15) {
+                        ll.push_front(gt[j]);
+                        ASSERT_EQ(addresses[j], &ll.front());
+                        ll.pop_front();
+                    }
+                }
+
+                ASSERT_EQ(allocs, mh.n_allocs());
+                ASSERT_EQ(true, ll.empty());
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Random edits agree with std::list
+        {
+            Memhook mh;
+
+            {
+                UnrolledList<int, 8> ll;
+                std::list<int> gt_ll;
+
+                for(size_t j = 0; j < n; j++) {
+                    const int value = gt[j];
+
+                    switch(t.range(6)) {
+                        case 0:
+                            ll.push_back(value);
+                            gt_ll.push_back(value);
+                            break;
+                        case 1:
+                            ll.push_front(value);
+                            gt_ll.push_front(value);
+                            break;
+                        case 2: {
+                            const size_t offset = t.range(gt_ll.size() + 1);
+                            auto it = ll.begin();
+                            auto gt_it = gt_ll.begin();
+                            std::advance(it, offset);
+                            std::advance(gt_it, offset);
+
+                            auto inserted = ll.insert(it, value);
+                            gt_ll.insert(gt_it, value);
+                            ASSERT_EQ(value, *inserted);
+                            break;
+                        }
+                        case 3:
+                            if(!gt_ll.empty()) {
+                                const size_t offset = t.range(gt_ll.size());
+                                auto it = ll.begin();
+                                auto gt_it = gt_ll.begin();
+                                std::advance(it, offset);
+                                std::advance(gt_it, offset);
+
+                                auto next = ll.erase(it);
+                                auto gt_next = gt_ll.erase(gt_it);
+                                ASSERT_EQ(true, (next == ll.end()) == (gt_next == gt_ll.end()));
+                                if(gt_next != gt_ll.end())
+                                    ASSERT_EQ(*gt_next, *next);
+                            }
+                            break;
+                        case 4:
+                            if(!gt_ll.empty()) {
+                                ll.pop_front();
+                                gt_ll.pop_front();
+                            }
+                            break;
+                        default:
+                            if(!gt_ll.empty()) {
+                                ll.pop_back();
+                                gt_ll.pop_back();
+                            }
+                            break;
+                    }
+
+                    if(!gt_ll.empty()) {
+                        ASSERT_EQ(gt_ll.front(), ll.front());
+                        ASSERT_EQ(gt_ll.back(), ll.back());
+                    }
+                }
+
+                ASSERT_EQ(true, consistent(ll, gt_ll));
+
+                // Copies and moves preserve the sequence
+                UnrolledList<int, 8> cpy = ll;
+                ASSERT_EQ(true, consistent(cpy, gt_ll));
+
+                UnrolledList<int, 8> moved = std::move(cpy);
+                ASSERT_EQ(true, consistent(moved, gt_ll));
+                ASSERT_EQ(0ULL, cpy.size());
+                ASSERT_EQ(true, cpy.begin() == cpy.end());
+
+                cpy = moved;
+                moved.clear();
+                ASSERT_EQ(true, moved.empty());
+                ASSERT_EQ(true, consistent(cpy, gt_ll));
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Elements are moved, not copied, between chunks
+        {
+            Memhook mh;
+
+            {
+                UnrolledList<Box<int>, 4> ll;
+
+                for(size_t j = 0; j < n; j++)
+                    ll.push_front(Box<int>(gt[j]));
+
+                for(size_t j = 0; j < n / 2; j++)
+                    ll.insert(ll.begin(), Box<int>(gt[j]));
+
+                ASSERT_EQ(n + n / 2, ll.size());
+
+                // Only the temporaries allocated payloads
+                size_t payload_allocs = 0;
+                for(size_t j = 0; j < mh.n_blocks(); j++)
+                    if(mh[j].size == sizeof(int))
+                        payload_allocs++;
+                ASSERT_EQ(n + n / 2, payload_allocs);
+            }
+
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+
+        // Drop-in container for Queue
+        {
+            Queue<int, UnrolledList<int>> q;
+            for(size_t j = 0; j < n; j++) {
+                q.push(gt[j]);
+                ASSERT_EQ(gt[j], q.back());
+            }
+
+            ASSERT_EQ(n, q.size());
+
+            Queue<int, UnrolledList<int>> q_cpy = q;
+            ASSERT_EQ(true, q == q_cpy);
+
+            for(size_t j = 0; j < n; j++) {
+                ASSERT_EQ(gt[j], q.front());
+                q.pop();
+            }
+
+            ASSERT_EQ(true, q.empty());
+        }
+    }
+}
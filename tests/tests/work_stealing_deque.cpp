@@ -0,0 +1,114 @@
+#include "executable.h"
+#include "WorkStealingDeque.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(work_stealing_deque) {
+    Typegen t;
+
+    // Single-threaded, the owner pops newest first and thieves oldest first
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        {
+            Memhook mh;
+
+            {
+                WorkStealingDeque<size_t> dq(4);
+                std::deque<size_t> gt;
+
+                for(size_t j = 0; j < n; j++) {
+                    size_t value = 0;
+
+                    switch(t.range(3)) {
+                        case 0:
+                            ASSERT_EQ(!gt.empty(), dq.pop(value));
+                            if(!gt.empty()) {
+                                ASSERT_EQ(gt.back(), value);
+                                gt.pop_back();
+                            }
+                            break;
+                        case 1:
+                            ASSERT_EQ(!gt.empty(), dq.steal(value));
+                            if(!gt.empty()) {
+                                ASSERT_EQ(gt.front(), value);
+                                gt.pop_front();
+                            }
+                            break;
+                        default:
+                            dq.push(j);
+                            gt.push_back(j);
+                            break;
+                    }
+
+                    ASSERT_EQ(gt.size(), dq.size());
+                }
+
+                // The ring only grows to fit the largest backlog
+                ASSERT_EQ(true, dq.capacity() >= gt.size());
+                ASSERT_EQ(true, dq.capacity() <= 2 * n + 4);
+            }
+
+            // Retired rings are freed with the deque
+            ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+        }
+    }
+
+    // An owner pushing and popping against several thieves: every
+    // element is taken exactly once
+    const size_t thieves = 3;
+    const size_t n = 0x7FFF;
+
+    for(size_t i = 0; i < 8; i++) {
+        WorkStealingDeque<size_t> dq(2);
+        std::unique_ptr<std::atomic<unsigned char>[]> seen(new std::atomic<unsigned char>[n]());
+        std::atomic<size_t> taken { 0 };
+
+        std::vector<std::thread> threads;
+        for(size_t k = 0; k < thieves; k++) {
+            threads.emplace_back([&] {
+                size_t value;
+                while(taken.load() < n) {
+                    if(dq.steal(value)) {
+                        seen[value]++;
+                        taken++;
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        size_t value;
+        for(size_t j = 0; j < n; j++) {
+            dq.push(j);
+            if(j % 3 == 0 && dq.pop(value)) {
+                seen[value]++;
+                taken++;
+            }
+        }
+        while(taken.load() < n) {
+            if(dq.pop(value)) {
+                seen[value]++;
+                taken++;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+
+        for(std::thread & thread : threads)
+            thread.join();
+
+        size_t taken_once = 0;
+        for(size_t j = 0; j < n; j++)
+            taken_once += seen[j].load() == 1;
+        ASSERT_EQ(n, taken_once);
+        ASSERT_EQ(true, dq.empty());
+    }
+}